@@ -62,13 +62,18 @@ for k in range(n_part_tot):
 # for i in range(n_part_2):
 #     patches += [plt.Circle((0,0), radius, color = color_2[i])]    
 
-file = open(pos_file, "r" )
-for line in file:
-    row = line.split()
-    row = [float(i) for i in row]
-    position.append(row)
-
-position = np.asarray(position)
+# a binary trajectory (trajectory_format) is mapped instead of parsed
+if(pos_file.endswith('.bin')):
+    from trajectory import read_trajectory
+    position = read_trajectory(pos_file)['xy'].reshape(-1, 2 * n_part_tot)
+else:
+    file = open(pos_file, "r" )
+    for line in file:
+        row = line.split()
+        row = [float(i) for i in row]
+        position.append(row)
+
+    position = np.asarray(position)
 numIter = len(position[:,0]) 
 
 # creates writing object to allow the movie to be
@@ -1,4 +1,5 @@
 import math
+import os
 import yaml
 
 with open("params.yaml",'r') as yf:
@@ -41,3 +42,13 @@ def calcPressure(d,t,n_part,vir):
 pressure,vir = calcPressure(red_dens,red_temp,n_part,vir)
 print("reduced pressure: ",pressure)
 print("virial: ",vir)
+
+# the run also writes the block averages of the energy, virial and pressure
+# (without the correction), with the standard error of each mean
+if os.path.exists('statistics.txt'):
+    with open('statistics.txt', 'r') as sf:
+        for line in sf:
+            if line.startswith('#'):
+                continue
+            name, n, mean, err, tau, block = line.split()
+            print(name + ": ", mean, "+-", err, "(tau_int", tau + ")")
@@ -0,0 +1,47 @@
+#include <catch2/catch.hpp>
+#include <string>
+
+#include "../src/AllocCounter.h"
+#include "../src/Parameters.h"
+#include "test_runs.hpp"
+
+// heap allocations of n_sweeps sweeps after equilibration, once the first
+// sweeps and property samples have set everything up. the output files go to
+// the temporary directory
+long long sweep_allocations(std::string yaml, int sweep_threads, int n_sweeps) {
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setSweepThreads(sweep_threads);
+    param.setOutputPrefix(temp_prefix("alloc_test_"));
+
+    int first = param.getEq_sweep() + 1;
+    int n_setup = 2 * param.getData_interval();
+    long long before = 0;
+    long long after = 0;
+    run_to_files(yaml, param, first, n_setup + n_sweeps, {},
+                 [&](Simulation *, int s) {
+                     if (s == first + n_setup - 1) {
+                         before = allocationCount();
+                     } else if (s == first + n_setup + n_sweeps - 1) {
+                         after = allocationCount();
+                     }
+                 });
+    return after - before;
+}
+
+TEST_CASE("Sweeps do not allocate after startup") {
+    REQUIRE(allocationCount() >= 0);
+
+    // the explicit images of a small periodic box
+    REQUIRE(sweep_allocations("catch_testing/alloc_params.yaml", 0, 200) == 0);
+    // cell and verlet lists, cluster moves and energy checks every sweep
+    REQUIRE(sweep_allocations("catch_testing/energy_params.yaml", 0, 100) ==
+            0);
+    // the same on the threads of the checkerboard sweep
+    REQUIRE(sweep_allocations("catch_testing/energy_params.yaml", 2, 100) ==
+            0);
+    // event chains of hard disks
+    REQUIRE(sweep_allocations("catch_testing/disk_params.yaml", 0, 100) == 0);
+    // a tabulated potential in the external well
+    REQUIRE(sweep_allocations("catch_testing/table_params.yaml", 0, 200) == 0);
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../src/Parameters.h"
+#include "../src/RdfAnalysis.h"
+#include "../src/Simulation.h"
+#include "../src/Trajectory.h"
+#include "../src/kiss.h"
+#include "test_runs.hpp"
+
+// frames of particles placed uniformly in the box, an ideal gas
+std::string ideal_gas_trajectory(Parameters *param, int n_frames) {
+    std::string path = std::string(P_tmpdir) + "/ideal_gas.bin";
+    int n = param->getNumParticles();
+    double box_L = param->getBoxLength();
+    std::vector<int> types(n);
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    for (int k = 0; k < n; k++) {
+        types[k] = k % 2 + 1;
+    }
+
+    KISSRNG rng;
+    rng.InitCold(param->getSeed());
+    TrajectoryWriter writer;
+    writer.open(path, n, 8, box_L, param->getPhysicsHash(), types.data());
+    for (int f = 0; f < n_frames; f++) {
+        for (int k = 0; k < n; k++) {
+            x[k] = box_L * (rng.RandomUniformDbl() - 0.5);
+            y[k] = box_L * (rng.RandomUniformDbl() - 0.5);
+        }
+        writer.writeFrame(f, x.data(), y.data());
+    }
+    writer.close();
+    return path;
+}
+
+TEST_CASE("The pair correlations of an ideal gas are one") {
+    Parameters param;
+    param.initializeParameters("catch_testing/large_params.yaml");
+    param.setOutputPrefix(std::string(P_tmpdir) + "/ideal_");
+    std::string path = ideal_gas_trajectory(&param, 20);
+
+    TrajectoryReader reader;
+    REQUIRE(reader.open(path));
+
+    RdfAnalysis serial;
+    serial.initializeRdfAnalysis(&param, 1);
+    REQUIRE(serial.sampleTrajectory(&reader) == 20);
+    serial.calcRDF();
+    serial.calcPCF();
+
+    // the threads count the same pairs
+    RdfAnalysis threaded;
+    threaded.initializeRdfAnalysis(&param, 3);
+    threaded.sampleTrajectory(&reader);
+    threaded.calcRDF();
+    threaded.calcPCF();
+    for (int ID = 0; ID < 3; ID++) {
+        REQUIRE(threaded.getRDF(ID) == serial.getRDF(ID));
+        REQUIRE(threaded.getPCF(ID) == serial.getPCF(ID));
+    }
+
+    // averaged over the shells past the first few sigma
+    const std::vector<double> &g = serial.getRDF(0);
+    const std::vector<double> &g_par = serial.getRDF(1);
+    double sum = 0;
+    double sum_par = 0;
+    int n_bins = 0;
+    for (int k = 40; k < int(g.size()) - 2; k++) {
+        sum = sum + g[k];
+        sum_par = sum_par + g_par[k];
+        n_bins++;
+    }
+    REQUIRE(sum / n_bins == Approx(1).epsilon(0.02));
+    REQUIRE(sum_par / n_bins == Approx(0.5).epsilon(0.03));
+
+    // and the 2D pair correlation away from the origin
+    const std::vector<std::vector<double>> &pcf = serial.getPCF(0);
+    int val = pcf.size();
+    double sum_xy = 0;
+    for (int k = val / 4; k < val / 2 - 20; k++) {
+        sum_xy = sum_xy + pcf[k][val / 2];
+    }
+    REQUIRE(sum_xy / (val / 4 - 20) == Approx(1).epsilon(0.1));
+
+    // the histograms written while sampling read back the same
+    RdfAnalysis reread;
+    reread.initializeRdfAnalysis(&param, 2);
+    REQUIRE(reread.readHistograms(std::string(P_tmpdir) + "/ideal_"));
+    reread.setNumSamples(20);
+    reread.calcRDF();
+    REQUIRE(reread.getRDF(2) == serial.getRDF(2));
+    REQUIRE_FALSE(reread.readHistograms(std::string(P_tmpdir) + "/none_"));
+}
+
+TEST_CASE("The virial integral agrees with the sampled virial") {
+    // a liquid of 400 Lennard-Jones particles in a periodic box
+    std::string yaml = "catch_testing/energy_params.yaml";
+    std::string prefix = temp_prefix("virial_run_");
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setTrajectoryFormat(1);
+    param.setOutputPrefix(prefix);
+
+    // the pressure of the samples, as it stands after the last sweep
+    int first = param.getEq_sweep() + 1;
+    double sampled = 0;
+    run_to_files(yaml, param, first, 1000, {}, [&](Simulation *sim, int s) {
+        if (s == first + 999) {
+            sampled = sim->getProperties()->calcPressure();
+        }
+    });
+
+    TrajectoryReader reader;
+    REQUIRE(reader.open(prefix + "trajectory.bin"));
+    param.setOutputPrefix(prefix + "analysis_");
+    RdfAnalysis analysis;
+    analysis.initializeRdfAnalysis(&param, 2);
+    REQUIRE(analysis.sampleTrajectory(&reader) == 20);
+    analysis.calcRDF();
+    std::cout << "pressure " << sampled << " sampled, "
+              << analysis.calcPressure() << " from the integral" << std::endl;
+    REQUIRE(analysis.calcPressure() == Approx(sampled).epsilon(0.08));
+}
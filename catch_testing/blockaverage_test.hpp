@@ -0,0 +1,66 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+
+#include "../src/BlockAverage.h"
+#include "../src/kiss.h"
+
+TEST_CASE("Block averages of uncorrelated samples") {
+    KISSRNG rng;
+    rng.InitCold(8923052835283572);
+
+    BlockAverage stats;
+    double sum = 0;
+    int n = 1 << 16;
+    for (int k = 0; k < n; k++) {
+        double x = rng.RandomUniformDbl();
+        sum = sum + x;
+        stats.add(x);
+    }
+
+    // the mean is the plain sum over the series
+    REQUIRE(stats.getCount() == n);
+    REQUIRE(stats.getMean() == sum / n);
+    REQUIRE(stats.getVariance() == Approx(1.0 / 12).epsilon(0.02));
+
+    REQUIRE(stats.getBlockLevel() >= 0);
+    REQUIRE(stats.getStdError() ==
+            Approx(sqrt(1.0 / 12 / n)).epsilon(0.15));
+    REQUIRE(stats.getTauInt() == Approx(0.5).epsilon(0.3));
+}
+
+TEST_CASE("Block averages of a correlated series") {
+    KISSRNG rng;
+    rng.InitCold(8923052835283572);
+
+    // x_k = phi x_k-1 + noise has tau_int = (1 + phi) / (1 - phi) / 2
+    double phi = 0.9;
+    BlockAverage stats;
+    double x = 0;
+    int n = 1 << 18;
+    for (int k = 0; k < n; k++) {
+        x = phi * x + rng.RandomUniformDbl() - 0.5;
+        stats.add(x);
+    }
+
+    double tau = 0.5 * (1 + phi) / (1 - phi);
+    REQUIRE(stats.getBlockLevel() > 2);
+    REQUIRE(stats.getTauInt() == Approx(tau).epsilon(0.2));
+
+    // the error of the mean is sqrt(2 tau) times the naive one
+    double naive = sqrt(stats.getVariance() / n);
+    REQUIRE(stats.getStdError() == Approx(sqrt(2 * tau) * naive).epsilon(0.1));
+}
+
+TEST_CASE("Block averages of short or constant series") {
+    BlockAverage stats;
+    REQUIRE(stats.getMean() == 0);
+    REQUIRE(stats.getBlockLevel() == -1);
+    REQUIRE(stats.getStdError() == 0);
+
+    for (int k = 0; k < 10; k++) {
+        stats.add(2.5);
+    }
+    REQUIRE(stats.getMean() == 2.5);
+    REQUIRE(stats.getStdError() == 0);
+    REQUIRE(stats.getTauInt() == 0.5);
+}
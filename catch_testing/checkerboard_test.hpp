@@ -0,0 +1,83 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <vector>
+
+#include "../src/Boundary.h"
+#include "../src/Checkerboard.h"
+#include "../src/EnergyTracker.h"
+#include "../src/Interaction.h"
+#include "../src/Parameters.h"
+#include "../src/ParticleStore.h"
+#include "../src/kiss.h"
+
+// runs checkerboard sweeps on n_threads threads and returns the positions,
+// after checking the running energy against a full recompute
+std::vector<double> checkerboard_run(int n_threads, int n_sweeps) {
+    static Parameters param;
+    param.initializeParameters("catch_testing/energy_params.yaml");
+    param.setSweepThreads(n_threads);
+
+    KISSRNG rng;
+    rng.InitCold(param.getSeed());
+
+    ParticleStore particles;
+    prepare_lattice(&particles, &param, &rng);
+    for (int k = 0; k < particles.size(); k++) {
+        particles.setStepWeight(k, 0.3);
+    }
+
+    Interaction interact;
+    interact.initializeInteraction(&param);
+    interact.buildNeighborLists(&particles);
+    Boundary bound;
+    bound.initializeBoundary(&param);
+
+    EnergyTracker energy;
+    energy.initializeEnergyTracker(&param);
+    energy.reset(&interact, &particles);
+
+    Checkerboard checker;
+    checker.initializeCheckerboard(&param, &interact);
+    REQUIRE(checker.isActive());
+    REQUIRE(checker.getNumDomains() >= 16);
+
+    int n_rejects = 0;
+    for (int s = 0; s < n_sweeps; s++) {
+        n_rejects = n_rejects +
+                    checker.sweep(&particles, &interact, &bound, &energy, &rng);
+    }
+    REQUIRE(n_rejects > 0);
+    REQUIRE(n_rejects < n_sweeps * particles.size());
+
+    double running = energy.getTotal();
+    std::vector<double> per_particle(particles.size());
+    for (int k = 0; k < particles.size(); k++) {
+        per_particle[k] = energy.getParticleEnergy(k);
+    }
+    energy.reset(&interact, &particles);
+    REQUIRE(fabs(running - energy.getTotal()) < 1e-9 * fabs(energy.getTotal()));
+    for (int k = 0; k < particles.size(); k++) {
+        REQUIRE(per_particle[k] ==
+                Approx(energy.getParticleEnergy(k)).margin(1e-6));
+    }
+
+    // the cell list has followed every accepted move
+    CellList *grid = interact.getCellList();
+    std::vector<double> positions;
+    for (int k = 0; k < particles.size(); k++) {
+        double x = particles.getX_Position(k);
+        double y = particles.getY_Position(k);
+        REQUIRE(grid->getCell(k) == grid->cellIndex(x, y));
+        positions.push_back(x);
+        positions.push_back(y);
+    }
+    return positions;
+}
+
+// every domain has a random number stream of its own, so the threads only
+// change who sweeps it
+TEST_CASE("Checkerboard sweeps do not depend on the number of threads") {
+    std::vector<double> serial = checkerboard_run(1, 20);
+    std::vector<double> parallel = checkerboard_run(3, 20);
+    REQUIRE(serial == parallel);
+}
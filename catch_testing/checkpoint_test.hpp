@@ -0,0 +1,213 @@
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "../src/Checkpoint.h"
+#include "../src/Parameters.h"
+#include "../src/Simulation.h"
+#include "test_runs.hpp"
+
+TEST_CASE("Checkpoints read back only whole and of the same run") {
+    std::string path = std::string(P_tmpdir) + "/parts.bin";
+    std::vector<double> values = {1.5, -2, 1e-300};
+
+    CheckpointWriter out;
+    out.put(42);
+    out.putVector(values);
+    out.put(7ULL);
+    REQUIRE(out.commit(path, 1234));
+    REQUIRE(out.size() == 32 + 4 + 8 + 24 + 8);
+    REQUIRE_FALSE(
+        std::ifstream(path + ".tmp" + std::to_string(getpid())).good());
+
+    CheckpointReader in;
+    REQUIRE(in.open(path, 1234));
+    int n = 0;
+    std::vector<double> read;
+    unsigned long long last = 0;
+    in.get(&n);
+    in.getVector(&read);
+    in.get(&last);
+    REQUIRE(in.isGood());
+    REQUIRE(n == 42);
+    REQUIRE(read == values);
+    REQUIRE(last == 7);
+
+    // past the end of the parts
+    in.get(&n);
+    REQUIRE_FALSE(in.isGood());
+
+    // another run, or a file cut short or changed
+    REQUIRE_FALSE(in.open(path, 1235));
+    REQUIRE(in.open(path));
+    REQUIRE(in.getRunHash() == 1234);
+    std::ifstream file(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(file)),
+                      std::istreambuf_iterator<char>());
+    std::ofstream(path, std::ios::binary)
+        .write(bytes.data(), bytes.size() - 1);
+    REQUIRE_FALSE(in.open(path, 1234));
+    bytes[40] = bytes[40] + 1;
+    std::ofstream(path, std::ios::binary).write(bytes.data(), bytes.size());
+    REQUIRE_FALSE(in.open(path, 1234));
+    REQUIRE_FALSE(in.open(path + ".none", 1234));
+
+    // a payload size far past the end of the file
+    bytes[40] = bytes[40] - 1;
+    CheckpointHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.payload_size = ~0ULL;
+    std::memcpy(&bytes[0], &header, sizeof(header));
+    std::ofstream(path, std::ios::binary).write(bytes.data(), bytes.size());
+    REQUIRE_FALSE(in.open(path, 1234));
+    REQUIRE_FALSE(in.isGood());
+}
+
+TEST_CASE("A stream goes on from its saved size") {
+    std::string path = std::string(P_tmpdir) + "/stream.txt";
+    std::ofstream file(path);
+    file << "1 2 ";
+    long long size = streamSize(&file);
+    file << "3 4 ";
+    file.close();
+    REQUIRE(size == 4);
+
+    REQUIRE(resumeStream(&file, path, size));
+    REQUIRE(streamSize(&file) == 4);
+    file << "5 ";
+    file.close();
+    std::ifstream read(path);
+    std::stringstream contents;
+    contents << read.rdbuf();
+    REQUIRE(contents.str() == "1 2 5 ");
+
+    // the same for the sample files
+    OutputWriter writer;
+    OutputFile sample;
+    sample.setWriter(&writer);
+    sample.open(path);
+    sample << 1.0 << " " << 2.0 << " ";
+    size = streamSize(&sample);
+    sample << 3.0 << " ";
+    sample.close();
+    REQUIRE(size == 4);
+    REQUIRE(resumeStream(&sample, path, size));
+    REQUIRE(streamSize(&sample) == 4);
+    sample << 5.0 << " ";
+    sample.close();
+    read.close();
+    read.open(path);
+    contents.str("");
+    contents << read.rdbuf();
+    REQUIRE(contents.str() == "1 2 5 ");
+}
+
+// sweeps eq_sweep - 100 up to n_sweeps later with a checkpoint every 100
+// sweeps, starting from the checkpoint with restart. a run stopped before
+// the last sweep is left unfinished, as if it had been killed
+int checkpointed_run(std::string yaml, Parameters param, bool restart,
+                     int n_sweeps, int stop) {
+    int first = param.getEq_sweep() - 100;
+    Simulation sim(yaml, param);
+    sim.setQuiet(true);
+    sim.setRestart(restart);
+    sim.initializeRun();
+
+    int start = restart ? sim.getFirstSweep() : first;
+    for (int s = start; s < first + stop; s++) {
+        sim.runSweep(s);
+        if ((s + 1) % 100 == 0) {
+            sim.writeCheckpoint(s + 1);
+        }
+    }
+    if (stop == n_sweeps) {
+        sim.finishRun();
+    }
+    return start;
+}
+
+// the run is stopped 50 sweeps after its checkpoint at eq_sweep + 100, after
+// it wrote a sample the checkpoint does not hold
+void compare_restart(std::string name, std::string yaml, int n_buffer,
+                     int format) {
+    std::string prefix = temp_prefix("ckpt_" + name);
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setAnalysisBuffer(n_buffer);
+    param.setTrajectoryFormat(format);
+
+    std::vector<std::string> names = {
+        "energies.txt",       "forces.txt",
+        "statistics.txt",     "numDensity.txt",
+        "par_numDensity.txt", "antp_xy_numDensity.txt",
+        "particleEnergies.txt", "avgForcePerParticle.txt"};
+    names.push_back(format > 0 ? "trajectory.bin" : "positions.txt");
+
+    // the same checkpoints, but never stopped
+    param.setOutputPrefix(prefix + "_whole_");
+    std::vector<std::string> whole = run_to_files(
+        yaml, param, param.getEq_sweep() - 100, 400, names,
+        [](Simulation *sim, int s) {
+            if ((s + 1) % 100 == 0) {
+                sim->writeCheckpoint(s + 1);
+            }
+        });
+
+    param.setOutputPrefix(prefix + "_stopped_");
+    std::remove((prefix + "_stopped_checkpoint.bin").c_str());
+    checkpointed_run(yaml, param, false, 400, 250);
+    REQUIRE(checkpointed_run(yaml, param, true, 400, 400) ==
+            param.getEq_sweep() + 100);
+    std::vector<std::string> restarted =
+        read_files(prefix + "_stopped_", names);
+    for (int f = 0; f < int(names.size()); f++) {
+        INFO(names[f]);
+        REQUIRE(restarted[f] == whole[f]);
+    }
+    REQUIRE(whole[0].size() > 0);
+}
+
+TEST_CASE("A restarted run goes on as if it had not stopped") {
+    // verlet lists, cluster moves and the running energies of the particles
+    SECTION("single moves") {
+        compare_restart("single", "catch_testing/energy_params.yaml", 0, 0);
+    }
+    SECTION("samples on the analysis thread, into a trajectory") {
+        compare_restart("analysed", "catch_testing/energy_params.yaml", 2,
+                        1);
+    }
+    SECTION("event chains") {
+        compare_restart("chains", "catch_testing/disk_params.yaml", 0, 0);
+    }
+}
+
+TEST_CASE("A run without a checkpoint starts from the first sweep") {
+    std::string yaml = "catch_testing/test_params.yaml";
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setOutputPrefix(temp_prefix("ckpt_none_"));
+    std::remove((param.getOutputPrefix() + "checkpoint.bin").c_str());
+
+    Simulation sim(yaml, param);
+    sim.setQuiet(true);
+    sim.setRestart(true);
+    sim.initializeRun();
+    REQUIRE(sim.getFirstSweep() == 0);
+
+    // nor from the checkpoint of another run, which the interval is not
+    sim.writeCheckpoint(100);
+    unsigned long long hash = param.getRunHash();
+    param.setCheckpointInterval(10);
+    REQUIRE(param.getRunHash() == hash);
+    param.setTrajectoryFormat(1);
+    Simulation other(yaml, param);
+    other.setQuiet(true);
+    other.setRestart(true);
+    other.initializeRun();
+    REQUIRE(other.getFirstSweep() == 0);
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <string>
+
+#include "../src/ConfigCache.h"
+#include "../src/Parameters.h"
+#include "../src/ParticleStore.h"
+#include "../src/Simulation.h"
+#include "test_runs.hpp"
+
+// an empty cache directory of its own for every test
+std::string empty_cache(std::string name, Parameters *param) {
+    std::string dir = std::string(P_tmpdir) + "/cache_" + name;
+    ConfigCache cache;
+    param->setConfigCache(dir);
+    cache.initializeConfigCache(param);
+    std::remove(cache.cachePath(param->getPhysicsHash()).c_str());
+    return dir;
+}
+
+TEST_CASE("A run finds the cached configuration closest to its own") {
+    Parameters param;
+    param.initializeParameters("catch_testing/energy_params.yaml");
+    empty_cache("closest", &param);
+
+    ParticleStore stored;
+    stored.resize(param.getNumParticles());
+    for (int k = 0; k < stored.size(); k++) {
+        stored.setType(k, 1 + k % 2);
+        stored.setX_Position(k, 0.01 * k);
+        stored.setY_Position(k, -0.02 * k);
+    }
+    ParticleStore loaded;
+    loaded.resize(param.getNumParticles());
+
+    ConfigCache cache;
+    cache.initializeConfigCache(&param);
+    REQUIRE_FALSE(cache.load(&loaded));
+    REQUIRE(cache.save(&stored));
+
+    // the same state point
+    REQUIRE(cache.load(&loaded));
+    REQUIRE(cache.isExact());
+    for (int k = 0; k < stored.size(); k++) {
+        REQUIRE(loaded.getType(k) == stored.getType(k));
+        REQUIRE(loaded.getX_Position(k) == stored.getX_Position(k));
+        REQUIRE(loaded.getY_Position(k) == stored.getY_Position(k));
+    }
+
+    // another temperature of the same system
+    Parameters hotter = param;
+    hotter.setRedTemp(2.0);
+    ConfigCache other;
+    other.initializeConfigCache(&hotter);
+    REQUIRE(other.load(&loaded));
+    REQUIRE_FALSE(other.isExact());
+    REQUIRE(other.getFound() == cache.getFound());
+    REQUIRE(other.getFoundTemp() == param.getRedTemp());
+    REQUIRE(loaded.getX_Position(7) == stored.getX_Position(7));
+
+    // another system altogether
+    Parameters small;
+    small.initializeParameters("catch_testing/alloc_params.yaml");
+    small.setConfigCache(param.getConfigCache());
+    ConfigCache none;
+    none.initializeConfigCache(&small);
+    REQUIRE_FALSE(none.load(&loaded));
+}
+
+TEST_CASE("A warm started run only re-equilibrates") {
+    std::string yaml = "catch_testing/test_params.yaml";
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setOutputPrefix(temp_prefix("cache_cold_"));
+    empty_cache("warm", &param);
+    param.setWarmStartSweeps(50);
+
+    // a cold start, cached after 200 sweeps
+    int first_sweep = -1;
+    double cold_energy = 0;
+    std::string cold_types =
+        run_to_files(yaml, param, 0, 200, {"particle_type.txt"},
+                     [&](Simulation *sim, int s) {
+                         if (s == 0) {
+                             first_sweep = sim->getFirstSweep();
+                         } else if (s == 199) {
+                             sim->cacheConfiguration();
+                             cold_energy = sim->potentialEnergy();
+                         }
+                     })[0];
+    REQUIRE(first_sweep == 0);
+
+    param.setOutputPrefix(temp_prefix("cache_warm_"));
+    Simulation warm(yaml, param);
+    warm.setQuiet(true);
+    warm.initializeRun();
+    REQUIRE(warm.getFirstSweep() == param.getEq_sweep() + 1 - 50);
+    REQUIRE(warm.potentialEnergy() == cold_energy);
+
+    // the particles are those of the cached configuration
+    REQUIRE(read_files(param.getOutputPrefix(), {"particle_type.txt"})[0] ==
+            cold_types);
+
+    // another state point settles for at least a tenth of the equilibration
+    param.setRedTemp(2.0);
+    Simulation hotter(yaml, param);
+    hotter.setQuiet(true);
+    hotter.initializeRun();
+    REQUIRE(hotter.getFirstSweep() ==
+            param.getEq_sweep() + 1 - param.getEq_sweep() / 10);
+}
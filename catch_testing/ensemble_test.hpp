@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/Ensemble.h"
+#include "../src/Parameters.h"
+#include "test_runs.hpp"
+
+// the numbers of a histogram file written by Properties::writeHistograms
+std::vector<double> histogram_values(std::string prefix, std::string name) {
+    std::stringstream text(read_files(prefix, {name})[0]);
+    std::vector<double> values;
+    double value = 0;
+    while (text >> value) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+// the merged number densities are those of one chain on average, with the
+// counts of the sampling threads of every chain merged in
+TEST_CASE("The ensemble averages the number densities of its chains") {
+    std::string yaml = "catch_testing/test_params.yaml";
+    std::string prefix = temp_prefix("ensemble_");
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setEnsembleChains(3);
+    param.setSampleThreads(2);
+    param.setOutputPrefix(prefix);
+
+    Ensemble ensemble;
+    ensemble.initializeEnsemble(yaml, &param);
+    ensemble.run();
+    REQUIRE(ensemble.getNumChains() == 3);
+
+    for (std::string name : {"numDensity.txt", "par_numDensity.txt",
+                             "antp_numDensity.txt", "xy_numDensity.txt"}) {
+        INFO(name);
+        std::vector<double> merged = histogram_values(prefix, name);
+        std::vector<double> sum(merged.size(), 0);
+        for (int c = 0; c < 3; c++) {
+            std::vector<double> chain = histogram_values(
+                prefix + "chain" + std::to_string(c) + "_", name);
+            REQUIRE(chain.size() == merged.size());
+            for (int k = 0; k < int(chain.size()); k++) {
+                sum[k] = sum[k] + chain[k];
+            }
+        }
+        // the files hold six digits
+        double total = 0;
+        double worst = 0;
+        for (int k = 0; k < int(merged.size()); k++) {
+            double diff = fabs(3 * merged[k] - sum[k]);
+            worst = fmax(worst, diff / fmax(sum[k], 1.0));
+            total = total + merged[k];
+        }
+        REQUIRE(worst < 1e-5);
+        REQUIRE(total > 0);
+    }
+}
@@ -0,0 +1,111 @@
+#include <catch2/catch.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include "../src/EventChain.h"
+#include "../src/Parameters.h"
+#include "../src/ParticleStore.h"
+#include "../src/kiss.h"
+
+Parameters *init_disk_params() {
+    static Parameters param;
+    param.initializeParameters("catch_testing/disk_params.yaml");
+    return &param;
+}
+
+// disks of radius .5 on a square lattice, which leaves a small gap between
+// neighbours at this density
+void prepare_disks(ParticleStore *particles, Parameters *param) {
+    int n_particles = param->getNumParticles();
+    double box_L = param->getBoxLength();
+    int per_row = int(ceil(sqrt(double(n_particles))));
+    double spacing = box_L / per_row;
+
+    particles->resize(n_particles);
+    for (int k = 0; k < n_particles; k++) {
+        particles->setType(k, k % 2 + 1);
+        particles->setRadius(k, .5);
+        particles->setStepWeight(k, .1);
+        particles->setX_Position(k,
+                                 -0.5 * box_L + spacing * (k % per_row + 0.5));
+        particles->setY_Position(k,
+                                 -0.5 * box_L + spacing * (k / per_row + 0.5));
+    }
+}
+
+// smallest distance between two disks less their contact distance
+double smallest_gap(ParticleStore *particles, double box_L) {
+    double gap = box_L;
+    for (int i = 0; i < particles->size(); i++) {
+        for (int k = i + 1; k < particles->size(); k++) {
+            double dx =
+                particles->getX_Position(k) - particles->getX_Position(i);
+            double dy =
+                particles->getY_Position(k) - particles->getY_Position(i);
+            dx = dx - box_L * floor(dx / box_L + 0.5);
+            dy = dy - box_L * floor(dy / box_L + 0.5);
+            double contact = particles->getRadius(i) + particles->getRadius(k);
+            gap = fmin(gap, sqrt(dx * dx + dy * dy) - contact);
+        }
+    }
+    return gap;
+}
+
+TEST_CASE("An event chain hands its length on at each collision") {
+    Parameters *param = init_disk_params();
+    ParticleStore particles;
+    prepare_disks(&particles, param);
+
+    EventChain chain;
+    chain.initializeEventChain(param);
+    REQUIRE(chain.isActive());
+    chain.build(param, &particles);
+
+    // the first disk of the bottom row runs into its right neighbour after
+    // closing the gap between them, which then carries on
+    double spacing = param->getBoxLength() / 20;
+    double gap = spacing - 1;
+    double x0 = particles.getX_Position(0);
+    double x1 = particles.getX_Position(1);
+    chain.runChain(&particles, 0, 0, 0.5 * gap + gap);
+
+    REQUIRE(particles.getX_Position(0) == Approx(x0 + gap));
+    REQUIRE(particles.getX_Position(1) == Approx(x1 + 0.5 * gap));
+    REQUIRE(chain.getNumEvents() == 1);
+}
+
+TEST_CASE("Event chains never overlap the disks") {
+    Parameters *param = init_disk_params();
+    double box_L = param->getBoxLength();
+    ParticleStore particles;
+    prepare_disks(&particles, param);
+
+    EventChain chain;
+    chain.initializeEventChain(param);
+    chain.build(param, &particles);
+
+    KISSRNG rng;
+    rng.InitCold(param->getSeed());
+
+    // each chain moves the disks by its length in total, which shows up in
+    // the sum of the coordinates up to whole box lengths
+    for (int c = 0; c < 500; c++) {
+        int dir = c % 2;
+        double before = 0;
+        for (int k = 0; k < particles.size(); k++) {
+            before = before + (dir == 0 ? particles.getX_Position(k)
+                                        : particles.getY_Position(k));
+        }
+        int index = int(rng.RandomUniformDbl() * particles.size());
+        chain.runChain(&particles, index, dir, chain.getChainLength());
+
+        double after = 0;
+        for (int k = 0; k < particles.size(); k++) {
+            after = after + (dir == 0 ? particles.getX_Position(k)
+                                      : particles.getY_Position(k));
+        }
+        double moved = (after - before - chain.getChainLength()) / box_L;
+        REQUIRE(moved == Approx(round(moved)).margin(1e-8));
+    }
+    REQUIRE(chain.getNumEvents() > 500);
+    REQUIRE(smallest_gap(&particles, box_L) > -1e-10);
+}
@@ -0,0 +1,159 @@
+#include <catch2/catch.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include "../src/EnergyTracker.h"
+#include "../src/Interaction.h"
+#include "../src/Parameters.h"
+#include "../src/ParticleStore.h"
+#include "../src/kiss.h"
+
+// a larger, periodic system so that the box holds more than 3x3 cells
+Parameters *init_large_params() {
+    static Parameters param;
+    param.initializeParameters("catch_testing/large_params.yaml");
+    return &param;
+}
+
+Parameters *init_verlet_params() {
+    static Parameters param;
+    param.initializeParameters("catch_testing/verlet_params.yaml");
+    return &param;
+}
+
+// places the particles on a jittered square lattice with alternating types
+void prepare_lattice(ParticleStore *particles, Parameters *param,
+                     KISSRNG *rng) {
+    int n_particles = param->getNumParticles();
+    double box_L = param->getBoxLength();
+    int per_row = int(ceil(sqrt(double(n_particles))));
+    double spacing = box_L / per_row;
+
+    particles->resize(n_particles);
+    for (int k = 0; k < n_particles; k++) {
+        particles->setType(k, k % 2 + 1);
+        particles->setX_Position(
+            k, -0.5 * box_L + spacing * (k % per_row + 0.5) +
+                   0.2 * spacing * (rng->RandomUniformDbl() - 0.5));
+        particles->setY_Position(
+            k, -0.5 * box_L + spacing * (k / per_row + 0.5) +
+                   0.2 * spacing * (rng->RandomUniformDbl() - 0.5));
+    }
+}
+
+// makes a series of accepted moves and compares the change in energy from the
+// neighbour structures with the original all-pairs loop
+void compare_neighbor_energies(Parameters *param, int n_moves) {
+    KISSRNG rng;
+    rng.InitCold(param->getSeed());
+
+    ParticleStore particles;
+    prepare_lattice(&particles, param, &rng);
+
+    Interaction all_pairs;
+    Interaction cells;
+    all_pairs.initializeInteraction(param);
+    cells.initializeInteraction(param);
+    cells.buildNeighborLists(&particles);
+
+    double box_L = param->getBoxLength();
+    for (int k = 0; k < n_moves; k++) {
+        int index = int(rng.RandomUniformDbl() * particles.size());
+        double dx = 0.3 * (rng.RandomUniformDbl() - 0.5);
+        double dy = 0.3 * (rng.RandomUniformDbl() - 0.5);
+        particles.setX_TrialPos(index, particles.getX_Position(index) + dx);
+        particles.setY_TrialPos(index, particles.getY_Position(index) + dy);
+        if (fabs(particles.getX_TrialPos(index)) > 0.5 * box_L ||
+            fabs(particles.getY_TrialPos(index)) > 0.5 * box_L) {
+            continue;
+        }
+
+        double expected = all_pairs.periodicInteraction(&particles, index);
+        REQUIRE(cells.periodicInteraction(&particles, index) ==
+                Approx(expected).margin(1e-9));
+
+        // accept the move and keep the cell list up to date
+        particles.acceptTrial(index);
+        cells.updateNeighborLists(&particles, index);
+    }
+}
+
+TEST_CASE("Cell list energies match the all-pairs periodic loop") {
+    compare_neighbor_energies(init_large_params(), 50);
+}
+
+TEST_CASE("Verlet list energies match the all-pairs periodic loop") {
+    // enough moves for several particles to leave their skin
+    compare_neighbor_energies(init_verlet_params(), 2000);
+}
+
+TEST_CASE("The running energy matches a full recompute") {
+    static Parameters param;
+    param.initializeParameters("catch_testing/energy_params.yaml");
+
+    KISSRNG rng;
+    rng.InitCold(param.getSeed());
+
+    ParticleStore particles;
+    prepare_lattice(&particles, &param, &rng);
+
+    Interaction interact;
+    interact.initializeInteraction(&param);
+    interact.buildNeighborLists(&particles);
+
+    EnergyTracker energy;
+    energy.initializeEnergyTracker(&param);
+    REQUIRE(energy.isPerParticle());
+    energy.reset(&interact, &particles);
+
+    double box_L = param.getBoxLength();
+    for (int k = 0; k < 2000; k++) {
+        int index = int(rng.RandomUniformDbl() * particles.size());
+        double dx = 0.3 * (rng.RandomUniformDbl() - 0.5);
+        double dy = 0.3 * (rng.RandomUniformDbl() - 0.5);
+        particles.setX_TrialPos(index, particles.getX_Position(index) + dx);
+        particles.setY_TrialPos(index, particles.getY_Position(index) + dy);
+        if (fabs(particles.getX_TrialPos(index)) > 0.5 * box_L ||
+            fabs(particles.getY_TrialPos(index)) > 0.5 * box_L) {
+            continue;
+        }
+
+        // every move is accepted, whatever its energy
+        double delta = interact.periodicInteraction(&particles, index) -
+                       interact.getTailCorr();
+        energy.acceptMove(&interact, &particles, index, delta);
+        particles.acceptTrial(index);
+        interact.updateNeighborLists(&particles, index);
+    }
+
+    std::vector<double> expected(particles.size());
+    double total = interact.totalEnergy(&particles, expected.data());
+    REQUIRE(energy.getTotal() == Approx(total).margin(1e-8));
+    for (int k = 0; k < particles.size(); k++) {
+        REQUIRE(energy.getParticleEnergy(k) ==
+                Approx(expected[k]).margin(1e-8));
+    }
+
+    // the check after the sweep finds only round-off. accepting every move
+    // leaves overlaps behind, so the total is large
+    energy.endSweep(0, &interact, &particles);
+    REQUIRE(energy.getNumChecks() == 1);
+    REQUIRE(energy.getMaxDrift() < 1e-12 * fabs(total));
+}
+
+TEST_CASE("Periodic distance uses the nearest image") {
+    Parameters *param = init_large_params();
+    Interaction interact;
+    interact.initializeInteraction(param);
+
+    double half_L = 0.5 * param->getBoxLength();
+    double sigma = param->getSigma();
+
+    // two particles just inside opposite walls are close through the wall
+    REQUIRE(interact.periodicDistance(-half_L + 0.25, half_L - 0.25, 0, 0) ==
+            Approx(0.5 / sigma));
+    REQUIRE(interact.periodicDistance(-half_L + 0.25, half_L - 0.25,
+                                      -half_L + 0.5, half_L - 0.5) ==
+            Approx(sqrt(0.5 * 0.5 + 1.0) / sigma));
+    REQUIRE(interact.periodicDistance(0, 1, 0, 1) ==
+            Approx(interact.distance(0, 1, 0, 1)));
+}
@@ -0,0 +1,160 @@
+#include <catch2/catch.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include "../src/DeltaKernel.h"
+#include "../src/Parameters.h"
+#include "../src/ParticleStore.h"
+#include "../src/Potential.h"
+#include "../src/Properties.h"
+#include "../src/Simulation.h"
+#include "../src/kiss.h"
+#include "test_runs.hpp"
+
+// random neighbours around the origin, some of them past the cutoff and some
+// across the periodic walls
+void prepare_block(int n, double box_L, KISSRNG *rng, std::vector<double> *x,
+                   std::vector<double> *y, std::vector<int> *type) {
+    x->resize(n);
+    y->resize(n);
+    type->resize(n);
+    for (int k = 0; k < n; k++) {
+        (*x)[k] = box_L * (rng->RandomUniformDbl() - 0.5);
+        (*y)[k] = box_L * (rng->RandomUniformDbl() - 0.5);
+        (*type)[k] = 1 + (rng->RandomUniformDbl() < 0.5);
+    }
+}
+
+// compares every kernel the cpu supports with the scalar one
+void compare_kernels(Parameters *param, int interact_type) {
+    KISSRNG rng;
+    rng.InitCold(param->getSeed());
+
+    Potential pot;
+    pot.initializePotential(param);
+
+    KernelParams p;
+    p.pair.initializePairParams(param, &pot, nullptr);
+    p.inv_sigma2 = 1 / (param->getSigma() * param->getSigma());
+    p.trunc_dist2 = pot.getTruncDist() * pot.getTruncDist();
+
+    KernelMove m;
+    m.type = 1;
+    m.x_curr = 0.1;
+    m.y_curr = -0.2;
+    m.x_temp = 0.25;
+    m.y_temp = -0.1;
+
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<int> type;
+
+    DeltaKernelFn scalar = deltaKernelScalar(interact_type);
+    for (int level = KERNEL_AVX2; level <= bestKernelLevel(); level++) {
+        DeltaKernelFn vec = deltaKernel(level, interact_type);
+        REQUIRE(vec != nullptr);
+
+        // every remainder of the vector loops, with and without wrapping
+        for (int n = 0; n < 40; n++) {
+            prepare_block(n, param->getBoxLength(), &rng, &x, &y, &type);
+            for (int wrap = 0; wrap < 2; wrap++) {
+                p.box_L = wrap ? param->getBoxLength() : 0;
+                p.inv_box_L = 1 / param->getBoxLength();
+
+                double expected =
+                    scalar(p, x.data(), y.data(), type.data(), n, m);
+                REQUIRE(vec(p, x.data(), y.data(), type.data(), n, m) ==
+                        Approx(expected).epsilon(1e-12).margin(1e-10));
+            }
+        }
+    }
+}
+
+TEST_CASE("Vectorized delta-energy kernels match the scalar kernel") {
+    Parameters lj_param;
+    lj_param.initializeParameters("catch_testing/large_params.yaml");
+    compare_kernels(&lj_param, 1);
+
+    // the spring parameters are only read by the WCA + spring kernel
+    Parameters spring_param;
+    spring_param.initializeParameters("catch_testing/table_params.yaml");
+    compare_kernels(&spring_param, 2);
+    compare_kernels(&spring_param, 3);
+}
+
+TEST_CASE("The scalar kernel matches the pair loops") {
+    Parameters *param = init_large_params();
+    Potential pot;
+    pot.initializePotential(param);
+    PairParams pair;
+    pair.initializePairParams(param, &pot, nullptr);
+
+    KernelParams p;
+    p.pair = pair;
+    p.inv_sigma2 = 1 / (param->getSigma() * param->getSigma());
+    p.trunc_dist2 = pot.getTruncDist() * pot.getTruncDist();
+
+    // one neighbour inside the cutoff from both positions
+    double x = 1.0;
+    double y = 0.5;
+    int type = 2;
+
+    KernelMove m;
+    m.type = 1;
+    m.x_temp = 0.1;
+
+    double r2_temp = (0.9 * 0.9 + 0.25) * p.inv_sigma2;
+    double r2_curr = (1.0 + 0.25) * p.inv_sigma2;
+    double expected = LennardJonesPair::energy(pair, r2_temp, 1) -
+                      LennardJonesPair::energy(pair, r2_curr, 1);
+    REQUIRE(deltaKernelScalar(1)(p, &x, &y, &type, 1, m) == Approx(expected));
+}
+
+// the kernels use the analytic forms, and the sampled energies have to come
+// from the same potential as the moves
+TEST_CASE("The samples use the potential of the moves") {
+    std::string yaml = "catch_testing/table_params.yaml";
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setOutputPrefix(temp_prefix("kernel_table_"));
+
+    param.setDeltaKernel(0);
+    Simulation loops(yaml, param);
+    REQUIRE(loops.getProperties()->isTabulated());
+
+    param.setDeltaKernel(1);
+    Simulation kernel(yaml, param);
+    REQUIRE_FALSE(kernel.getProperties()->isTabulated());
+}
+
+// the average energy and pressure of one sample of a perturbed lattice, with
+// the table used or not as the interaction decided
+std::vector<double> lattice_sample(Parameters *param, bool tabulated) {
+    KISSRNG rng;
+    rng.InitCold(param->getSeed());
+    ParticleStore particles;
+    prepare_lattice(&particles, param, &rng);
+
+    Properties prop;
+    prop.initializeProperties(param);
+    prop.setTabulated(tabulated);
+    prop.calcPeriodicProp(&particles);
+    return {prop.calcAvgEnergy(), prop.calcPressure()};
+}
+
+// both periodic branches, the explicit images of a box smaller than twice
+// the cutoff and the nearest images of a large one
+TEST_CASE("Samples left without the table use the analytic forms") {
+    for (std::string yaml : {"catch_testing/alloc_params.yaml",
+                             "catch_testing/large_params.yaml"}) {
+        Parameters analytic;
+        analytic.initializeParameters(yaml);
+        analytic.setOutputPrefix(temp_prefix("kernel_analytic_"));
+        Parameters table = analytic;
+        table.setTableSize(4096);
+
+        std::vector<double> expected = lattice_sample(&analytic, false);
+        REQUIRE(lattice_sample(&table, false) == expected);
+        // the table itself is not exact
+        REQUIRE(lattice_sample(&table, true) != expected);
+    }
+}
@@ -1,5 +1,23 @@
 #define CATCH_CONFIG_MAIN
 #include "catch2/catch.hpp"
 
+#include "alloc_test.hpp"
+#include "analysis_test.hpp"
+#include "blockaverage_test.hpp"
+#include "checkpoint_test.hpp"
+#include "configcache_test.hpp"
+#include "ensemble_test.hpp"
+#include "eventchain_test.hpp"
+#include "interaction_test.hpp"
+#include "kernel_test.hpp"
+#include "output_test.hpp"
+#include "pipeline_test.hpp"
+#include "potential_test.hpp"
 #include "properties_test.hpp"
+#include "replica_test.hpp"
+#include "rng_test.hpp"
+#include "trajectory_test.hpp"
+#include "vmmc_test.hpp"
 
+// uses prepare_lattice from the interaction tests
+#include "checkerboard_test.hpp"
@@ -0,0 +1,115 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "../src/OutputWriter.h"
+#include "../src/Parameters.h"
+
+std::string formatted(double value) {
+    char out[32];
+    return std::string(out, formatNumber(out, value));
+}
+
+TEST_CASE("Numbers are formatted as printf and ofstream write them") {
+    // halfway cases, the edges of the fixed notation and of the fast range
+    double values[] = {0,        -0.0,      0.5,        2.5,
+                       1.0000005, 9.999995, 123456.5,   999999.5,
+                       1e-5,      1e-4,     0.000123456, 1e6,
+                       999999,    -7.25,    1e-19,      9.99999e18,
+                       1e19,      1e-300,   5e-324,     1.7976931348623157e308,
+                       std::numeric_limits<double>::infinity(),
+                       -std::numeric_limits<double>::infinity(),
+                       std::numeric_limits<double>::quiet_NaN()};
+    for (double value : values) {
+        char expected[32];
+        std::snprintf(expected, sizeof(expected), "%g", value);
+        INFO(expected);
+        REQUIRE(formatted(value) == expected);
+    }
+
+    std::mt19937_64 gen(11);
+    std::uniform_real_distribution<double> mantissa(-10, 10);
+    std::uniform_int_distribution<int> exponent(-25, 25);
+    for (int n = 0; n < 200000; n++) {
+        double value = mantissa(gen) * std::pow(10.0, exponent(gen));
+        if (n % 4 == 0) {
+            value = std::round(value * 1e4) / 1e4; // short decimals
+        }
+        char expected[32];
+        std::snprintf(expected, sizeof(expected), "%g", value);
+        INFO(expected);
+        REQUIRE(formatted(value) == expected);
+    }
+
+    std::ostringstream stream;
+    stream << -3.14159265 << " " << 2e-7 << " " << 1234567.0;
+    REQUIRE(formatted(-3.14159265) + " " + formatted(2e-7) + " " +
+                formatted(1234567.0) ==
+            stream.str());
+}
+
+// the numbers 0 .. n / 7, space separated, as an ofstream writes them
+std::string numbers_text(int n) {
+    std::ostringstream text;
+    for (int k = 0; k < n; k++) {
+        text << k / 7.0 << " ";
+    }
+    return text.str();
+}
+
+std::string file_text(std::string path) {
+    std::ifstream file(path);
+    std::stringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+TEST_CASE("Sample files are written whole on the output thread") {
+    Parameters param;
+    param.setOutputBuffer(1); // a kilobyte, so the buffers change often
+    OutputWriter writer;
+    writer.initializeOutputWriter(&param);
+
+    std::string path_a = std::string(P_tmpdir) + "/output_a.txt";
+    std::string path_b = std::string(P_tmpdir) + "/output_b.txt";
+    std::string path_c = std::string(P_tmpdir) + "/output_c.txt";
+    OutputFile a;
+    OutputFile b;
+    OutputFile c; // written on the calling thread
+    a.setWriter(&writer);
+    b.setWriter(&writer);
+    REQUIRE(a.open(path_a));
+    REQUIRE(b.open(path_b));
+    REQUIRE(c.open(path_c));
+    for (int k = 0; k < 20000; k++) {
+        a << k / 7.0 << " ";
+        b << k / 7.0 << " ";
+        c << k / 7.0 << " ";
+    }
+    std::string expected = numbers_text(20000);
+    REQUIRE(a.getSize() == (long long)expected.size());
+
+    // everything put so far is in the file after a flush
+    a.flush();
+    REQUIRE(file_text(path_a) == expected);
+    a.close();
+    b.close();
+    c.close();
+    REQUIRE(file_text(path_b) == expected);
+    REQUIRE(file_text(path_c) == expected);
+    REQUIRE(writer.getNumBytes() == 2 * (long long)expected.size());
+    REQUIRE_FALSE(writer.hasFailed());
+    REQUIRE(writer.getBlockedTime() >= 0);
+
+    // and goes on at the end
+    REQUIRE(a.open(path_a, true));
+    REQUIRE(a.getSize() == (long long)expected.size());
+    a << "\n";
+    a.close();
+    REQUIRE(file_text(path_a) == expected + "\n");
+}
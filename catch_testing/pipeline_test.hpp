@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/AnalysisPipeline.h"
+#include "../src/Parameters.h"
+#include "../src/ParticleStore.h"
+#include "test_runs.hpp"
+
+TEST_CASE("The analysis ring hands every snapshot over in order") {
+    ParticleStore particles;
+    particles.resize(5);
+
+    // a slow analysis, so that the three slots fill up
+    std::vector<int> sweeps;
+    std::vector<double> first_x;
+    AnalysisPipeline pipeline;
+    pipeline.initializeAnalysisPipeline(
+        3, 5, false, [&](const Snapshot &snapshot) {
+            sweeps.push_back(snapshot.sweep);
+            first_x.push_back(snapshot.x_position[0]);
+            if (snapshot.sweep % 50 == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    REQUIRE(pipeline.isActive());
+
+    for (int s = 0; s < 500; s++) {
+        particles.setX_Position(0, s);
+        pipeline.push(s, &particles, nullptr);
+    }
+    pipeline.finish();
+
+    REQUIRE(sweeps.size() == 500);
+    for (int s = 0; s < 500; s++) {
+        REQUIRE(sweeps[s] == s);
+        REQUIRE(first_x[s] == s);
+    }
+    REQUIRE(pipeline.getNumPushes() == 500);
+    REQUIRE(pipeline.getMaxOccupancy() <= 3);
+    REQUIRE(pipeline.getAvgOccupancy() <= 3);
+}
+
+// runs n_sweeps sweeps after equilibration with the samples analysed on the
+// chain (n_buffer = 0) or on the analysis thread, and returns the contents
+// of the named output files
+std::vector<std::string> analysed_files(std::string yaml, int n_buffer,
+                                        int n_sweeps,
+                                        std::vector<std::string> names) {
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setAnalysisBuffer(n_buffer);
+    param.setOutputPrefix(
+        temp_prefix("pipeline" + std::to_string(n_buffer) + "_"));
+    return run_to_files(yaml, param, param.getEq_sweep() + 1, n_sweeps,
+                        names);
+}
+
+TEST_CASE("The analysis thread writes what the chain would") {
+    std::vector<std::string> names = {"positions.txt", "particleEnergies.txt",
+                                      "numDensity.txt", "xy_numDensity.txt",
+                                      "forces.txt", "energies.txt"};
+
+    // per particle energies in a periodic box of 400 particles
+    std::string yaml = "catch_testing/energy_params.yaml";
+    std::vector<std::string> chain = analysed_files(yaml, 0, 500, names);
+    REQUIRE(chain[0].size() > 0);
+    REQUIRE(chain[1].size() > 0);
+    REQUIRE(analysed_files(yaml, 1, 500, names) == chain);
+    REQUIRE(analysed_files(yaml, 4, 500, names) == chain);
+}
@@ -0,0 +1,96 @@
+#include <catch2/catch.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include "../src/PairPotentials.h"
+#include "../src/Parameters.h"
+#include "../src/Potential.h"
+
+// the WCA + spring potential, tabulated
+Parameters *init_table_params() {
+    static Parameters param;
+    param.initializeParameters("catch_testing/table_params.yaml");
+    return &param;
+}
+
+TEST_CASE("Analytic derivatives match finite differences") {
+    Potential pot;
+    pot.initializePotential(init_table_params());
+
+    double h = 1e-6;
+    for (double r = 0.9; r < 3.0; r = r + 0.1) {
+        double de = (pot.energy(r + h, 2) - pot.energy(r - h, 2)) / (2 * h);
+        double df = (pot.force(r + h, 2) - pot.force(r - h, 2)) / (2 * h);
+        REQUIRE(pot.energyDeriv(r, 2) == Approx(de).epsilon(1e-5).margin(1e-7));
+        REQUIRE(pot.forceDeriv(r, 2) == Approx(df).epsilon(1e-5).margin(1e-7));
+    }
+}
+
+TEST_CASE("Tabulated potential matches the analytic forms") {
+    Parameters *param = init_table_params();
+    Potential pot;
+    PotentialTable table;
+    pot.initializePotential(param);
+    table.initializeTable(param, &pot);
+    REQUIRE(table.isActive());
+
+    double a_par = param->getRefAffinity();
+    double a_antp = a_par * param->getAffinityMult();
+    double r_cut = pot.getTruncDist();
+
+    for (double r = 0.8; r < r_cut; r = r + 0.0137) {
+        REQUIRE(table.energy(r * r, 0) ==
+                Approx(pot.energy(r, a_par)).epsilon(1e-6).margin(1e-8));
+        REQUIRE(table.energy(r * r, 1) ==
+                Approx(pot.energy(r, a_antp)).epsilon(1e-6).margin(1e-8));
+        REQUIRE(table.force(r * r, 1) ==
+                Approx(pot.force(r, a_antp)).epsilon(1e-6).margin(1e-8));
+    }
+
+    // either side of the kink at the WCA cutoff
+    double r_wca = pot.getWCA_Cut();
+    REQUIRE(table.force(pow(r_wca * (1 - 1e-9), 2), 0) ==
+            Approx(pot.force(r_wca * (1 - 1e-9), a_par)).margin(1e-6));
+    REQUIRE(table.force(pow(r_wca * (1 + 1e-9), 2), 0) ==
+            Approx(pot.force(r_wca * (1 + 1e-9), a_par)).margin(1e-6));
+}
+
+TEST_CASE("Pair policies match the analytic forms") {
+    Parameters *param = init_table_params();
+    Potential pot;
+    PotentialTable table;
+    PairParams pair;
+    pot.initializePotential(param);
+    table.initializeTable(param, &pot);
+    pair.initializePairParams(param, &pot, &table);
+
+    double a_antp = param->getRefAffinity() * param->getAffinityMult();
+
+    for (double r = 0.8; r < 4.0; r = r + 0.0137) {
+        double r2 = r * r;
+        REQUIRE(WCAPair::energy(pair, r2, 1) ==
+                Approx(pot.WCA_energy(r)).margin(1e-12));
+        REQUIRE(WCAPair::force(pair, r2, r, 1) ==
+                Approx(pot.WCA_force(r)).margin(1e-12));
+        REQUIRE(WCASpringPair::energy(pair, r2, 1) ==
+                Approx(pot.energy(r, a_antp)).margin(1e-12));
+        REQUIRE(WCASpringPair::force(pair, r2, r, 1) ==
+                Approx(pot.force(r, a_antp)).margin(1e-12));
+        REQUIRE(TabulatedPair::energy(pair, r2, 1) ==
+                Approx(table.energy(r2, 1)).margin(1e-12));
+    }
+
+    // the LJ policy carries the truncation shift of its own parameter file
+    Parameters lj_param;
+    lj_param.initializeParameters("catch_testing/large_params.yaml");
+    Potential lj;
+    lj.initializePotential(&lj_param);
+    pair.initializePairParams(&lj_param, &lj, nullptr);
+
+    double a_par = lj_param.getRefAffinity();
+    for (double r = 0.8; r < 2.5; r = r + 0.0137) {
+        REQUIRE(LennardJonesPair::energy(pair, r * r, 0) ==
+                Approx(lj.lenJonesEnergy(r, a_par)).margin(1e-12));
+        REQUIRE(LennardJonesPair::force(pair, r * r, r, 0) ==
+                Approx(lj.lenJonesForce(r, a_par)).margin(1e-12));
+    }
+}
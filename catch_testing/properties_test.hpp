@@ -1,9 +1,14 @@
 #include <catch2/catch.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 #include "../src/Parameters.h"
-#include "../src/Particle.h"
+#include "../src/ParticleStore.h"
 #include "../src/Properties.h"
+#include "../src/kiss.h"
+#include "test_runs.hpp"
 
 // come back and "un" hardcode the yaml file.. prob bad practice
 Parameters *init_test_params() {
@@ -12,23 +17,17 @@ Parameters *init_test_params() {
     return &param;
 }
 
-void prepare_particles(std::vector<Particle> *p) {
-
-    Particle p1;
-    Particle p2;
-    Particle p3;
-    Particle p4;
-
-    p1.setX_Position(-.5);
-    p1.setY_Position(.5);
-    p2.setX_Position(.5);
-    p2.setY_Position(.5);
-    p3.setX_Position(.5);
-    p3.setY_Position(-.5);
-    p4.setX_Position(-.5);
-    p4.setY_Position(-.5);
-
-    *p = {p1, p2, p3, p4};
+void prepare_particles(ParticleStore *p) {
+    p->resize(4);
+
+    p->setX_Position(0, -.5);
+    p->setY_Position(0, .5);
+    p->setX_Position(1, .5);
+    p->setY_Position(1, .5);
+    p->setX_Position(2, .5);
+    p->setY_Position(2, -.5);
+    p->setX_Position(3, -.5);
+    p->setY_Position(3, -.5);
 }
 
 // the x and y here represent the distance between the particles, not the
@@ -57,20 +56,18 @@ void average_force_vec(std::vector<std::vector<double>> *Force) {
 
 void compute_f_vecs(std::vector<double> *tot_f, int k, Properties *prop) {
 
-    std::vector<Particle> particles;
-    prepare_particles(&particles);
-    Particle p_reff = particles[k];
+    ParticleStore p;
+    prepare_particles(&p);
 
     for (int i = 0; i < 4; ++i) {
         if (i != k) {
-            Particle p = particles[i];
             double r =
-                prop->radDistance(p_reff.getX_Position(), p.getX_Position(),
-                                  p_reff.getY_Position(), p.getY_Position());
+                prop->radDistance(p.getX_Position(k), p.getX_Position(i),
+                                  p.getY_Position(k), p.getY_Position(i));
             // not sure what the c = 1 was originally for...
             double F = prop->lenJonesForce(r, 1);
-            prop->calc_force_vec(p.getX_Position() - p_reff.getX_Position(),
-                                 p.getY_Position() - p_reff.getY_Position(), r,
+            prop->calc_force_vec(p.getX_Position(i) - p.getX_Position(k),
+                                 p.getY_Position(i) - p.getY_Position(k), r,
                                  tot_f);
         }
     }
@@ -101,3 +98,150 @@ TEST_CASE("Lennard Jones Force Calculation") {
                   << std::endl;
     }
 }
+
+// samples a perturbed lattice with the properties of param on n_threads
+// threads, writes them out and returns the energies and the virials
+std::vector<double> threaded_sample(Parameters *param, int n_threads) {
+    param->setSampleThreads(n_threads);
+    param->setOutputPrefix(
+        temp_prefix("sample" + std::to_string(n_threads) + "_"));
+
+    KISSRNG rng;
+    rng.InitCold(param->getSeed());
+    ParticleStore particles;
+    prepare_lattice(&particles, param, &rng);
+
+    Properties prop;
+    prop.initializeProperties(param);
+    for (int s = 0; s < 3; s++) {
+        if (param->getBound_Type() == 1) {
+            prop.calcPeriodicProp(&particles);
+        } else {
+            prop.calcNonPerProp(&particles);
+        }
+    }
+    prop.writeProperties();
+    return {prop.calcAvgEnergy(), prop.calcPressure()};
+}
+
+// the whole contents of a file written by threaded_sample
+std::string sample_file(int n_threads, std::string name) {
+    return read_files(temp_prefix("sample" + std::to_string(n_threads) + "_"),
+                      {name})[0];
+}
+
+// the threads count into histograms of their own and the energies are summed
+// per block of particles, so the number of threads changes nothing
+TEST_CASE("Threaded sampling matches the serial loops") {
+    std::vector<std::string> names = {
+        "numDensity.txt",        "par_numDensity.txt",
+        "antp_numDensity.txt",   "xy_numDensity.txt",
+        "par_xy_numDensity.txt", "antp_xy_numDensity.txt",
+        "forces.txt",            "energies.txt",
+        "avgForcePerParticle.txt"};
+
+    // periodic (minimum image) and in the external well
+    std::vector<std::string> files = {"catch_testing/large_params.yaml",
+                                      "catch_testing/test_params.yaml"};
+    for (std::string f : files) {
+        Parameters param;
+        param.initializeParameters(f);
+
+        std::vector<double> serial = threaded_sample(&param, 0);
+        std::vector<double> one = threaded_sample(&param, 1);
+        std::vector<double> three = threaded_sample(&param, 3);
+
+        // the sums over the blocks only differ in their rounding
+        REQUIRE(one[0] == Approx(serial[0]).epsilon(1e-12));
+        REQUIRE(one[1] == Approx(serial[1]).epsilon(1e-12));
+        REQUIRE(three == one);
+
+        // the counts and the per particle forces are the same numbers
+        for (int k : {0, 1, 2, 3, 4, 5, 8}) {
+            REQUIRE(sample_file(1, names[k]) == sample_file(0, names[k]));
+        }
+        for (int k = 0; k < int(names.size()); k++) {
+            REQUIRE(sample_file(3, names[k]) == sample_file(1, names[k]));
+        }
+    }
+}
+
+// the bin of the separation x,y as Properties::xyBin finds it, false if it
+// is outside of the histogram
+bool xy_bin(double x, double y, double box, double cell, int *i, int *j) {
+    double half = .5 * box;
+    *i = (x + half) / cell;
+    *j = (y + half) / cell;
+    if (fabs(x) >= half - cell || fabs(y) >= half - cell) {
+        return false;
+    }
+    *i = *i + (x > (*i + 0.5) * cell - half);
+    *j = *j + (y > (*j + 0.5) * cell - half);
+    return true;
+}
+
+// a box smaller than twice the cutoff: a pair beyond the cutoff is summed
+// over the images of the other particle, and the xy density counts each
+// image once from either particle, in opposite directions
+TEST_CASE("Explicit images count the xy density in both directions") {
+    Parameters param;
+    param.initializeParameters("catch_testing/alloc_params.yaml");
+    param.setOutputPrefix(std::string(P_tmpdir) + "/images_");
+    Potential potential;
+    potential.initializePotential(&param);
+    double trunc = potential.getTruncDist();
+    double box = param.getBoxLength();
+    double cell = param.getSigma() / 20;
+    REQUIRE(trunc * param.getSigma() > 0.5 * box);
+
+    int n = param.getNumParticles();
+    KISSRNG rng;
+    rng.InitCold(param.getSeed());
+    ParticleStore particles;
+    particles.resize(n);
+    for (int k = 0; k < n; k++) {
+        particles.setType(k, 1 + k % 2);
+        particles.setX_Position(k, box * (rng.RandomUniformDbl() - 0.5));
+        particles.setY_Position(k, box * (rng.RandomUniformDbl() - 0.5));
+    }
+    Properties prop;
+    prop.initializeProperties(&param);
+    prop.calcPeriodicProp(&particles);
+
+    const std::vector<std::vector<double>> &xy = prop.getXY_Density(0);
+    std::vector<std::vector<double>> expected(
+        xy.size(), std::vector<double>(xy.size(), 0));
+    int i = 0;
+    int j = 0;
+    for (int a = 0; a < n; a++) {
+        for (int b = 0; b < n; b++) {
+            if (a == b) {
+                continue;
+            }
+            double dx = particles.getX_Position(b) - particles.getX_Position(a);
+            double dy = particles.getY_Position(b) - particles.getY_Position(a);
+            if (xy_bin(dx, dy, box, cell, &i, &j)) {
+                expected[i][j]++;
+            }
+            if (b < a || sqrt(dx * dx + dy * dy) <= trunc) {
+                continue;
+            }
+            for (int sx = -1; sx <= 1; sx++) {
+                for (int sy = -1; sy <= 1; sy++) {
+                    if (sx == 0 && sy == 0) {
+                        continue;
+                    }
+                    double ix = dx + sx * box;
+                    double iy = dy + sy * box;
+                    if (xy_bin(ix, iy, box, cell, &i, &j)) {
+                        expected[i][j]++;
+                    }
+                    if (xy_bin(-ix, -iy, box, cell, &i, &j)) {
+                        expected[i][j]++;
+                    }
+                }
+            }
+        }
+    }
+    REQUIRE(xy == expected);
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+
+#include "../src/Parameters.h"
+#include "../src/Philox.h"
+#include "../src/ReplicaExchange.h"
+#include "../src/Simulation.h"
+#include "../src/kiss.h"
+
+// an exchange and the exchange back have to balance the Boltzmann weights of
+// the two configurations
+TEST_CASE("Replica swaps satisfy detailed balance") {
+    ReplicaExchange pt;
+
+    double t_m = 0.5;
+    double t_n = 0.8;
+    double u_a = -120.0;
+    double u_b = -95.0;
+
+    // energies that do not depend on the temperature: the lower energy
+    // already sits at the lower temperature
+    REQUIRE(pt.swapProbability(t_m, t_n, u_a, u_b, u_b, u_a) < 1);
+    REQUIRE(pt.swapProbability(t_m, t_n, u_b, u_a, u_a, u_b) == 1);
+
+    // a at t_m and b at t_n, against b at t_m and a at t_n
+    double w_ab = exp(-u_a / t_m - u_b / t_n);
+    double w_ba = exp(-u_b / t_m - u_a / t_n);
+    double forward = w_ab * pt.swapProbability(t_m, t_n, u_a, u_b, u_b, u_a);
+    double reverse = w_ba * pt.swapProbability(t_m, t_n, u_b, u_a, u_a, u_b);
+    REQUIRE(forward == Approx(reverse).epsilon(1e-12));
+
+    // the same temperature always swaps
+    REQUIRE(pt.swapProbability(t_m, t_m, u_a, u_b, u_b, u_a) == 1);
+}
+
+// the spring energy of interactionType 3 scales with the temperature, so the
+// two replicas do not share a Hamiltonian
+TEST_CASE("Replica swaps balance replicas of different Hamiltonians") {
+    std::string yaml = "catch_testing/table_params.yaml";
+    Parameters param;
+    param.initializeParameters(yaml);
+    REQUIRE(param.getInteract_Type() == 3);
+
+    double t_m = 0.8;
+    double t_n = 1.6;
+    param.setRedTemp(t_m);
+    param.setOutputPrefix(std::string(P_tmpdir) + "/swap_m_");
+    Simulation sim_m(yaml, param);
+    param.setRedTemp(t_n);
+    param.setStream(1);
+    param.setOutputPrefix(std::string(P_tmpdir) + "/swap_n_");
+    Simulation sim_n(yaml, param);
+    sim_m.setQuiet(true);
+    sim_n.setQuiet(true);
+    sim_m.initializeRun();
+    sim_n.initializeRun();
+    for (int s = 0; s < 200; s++) {
+        sim_m.runSweep(s);
+        sim_n.runSweep(s);
+    }
+
+    double u_mm = sim_m.potentialEnergy();
+    double u_nn = sim_n.potentialEnergy();
+    sim_m.swapConfiguration(&sim_n);
+    double u_mn = sim_m.potentialEnergy();
+    double u_nm = sim_n.potentialEnergy();
+
+    // each configuration has another energy under the other Hamiltonian
+    REQUIRE(u_mn != Approx(u_nn));
+    REQUIRE(u_nm != Approx(u_mm));
+
+    // and the exchange back restores the energies
+    sim_m.swapConfiguration(&sim_n);
+    REQUIRE(sim_m.potentialEnergy() == Approx(u_mm).epsilon(1e-12));
+    REQUIRE(sim_n.potentialEnergy() == Approx(u_nn).epsilon(1e-12));
+
+    ReplicaExchange pt;
+    double w_before = exp(-u_mm / t_m - u_nn / t_n);
+    double w_after = exp(-u_mn / t_m - u_nm / t_n);
+    double forward = w_before * pt.swapProbability(t_m, t_n, u_mm, u_nn,
+                                                   u_mn, u_nm);
+    double reverse = w_after * pt.swapProbability(t_m, t_n, u_mn, u_nm,
+                                                  u_mm, u_nn);
+    REQUIRE(forward == Approx(reverse).epsilon(1e-12));
+}
+
+// the swaps draw from the generator the replicas use, in the stream after
+// theirs
+TEST_CASE("Replica swaps draw from the generator of the replicas") {
+    std::string yaml = "catch_testing/table_params.yaml";
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setReplicaTemps({0.8, 1.6});
+    param.setOutputPrefix(std::string(P_tmpdir) + "/swap_rng_");
+
+    for (int rng_type : {0, 1}) {
+        param.setRngType(rng_type);
+        ReplicaExchange pt;
+        pt.initializeReplicaExchange(yaml, &param);
+        double drawn = pt.getSwapRNG()->RandomUniformDbl();
+
+        Parameters sp = param;
+        sp.setStream(3);
+        double expected = 0;
+        if (rng_type == 1) {
+            PhiloxRNG philox;
+            philox.Init(sp.getSeed(), sp.getStream());
+            expected = philox.RandomUniformDbl();
+        } else {
+            KISSRNG kiss;
+            kiss.InitCold(sp.getStreamSeed());
+            expected = kiss.RandomUniformDbl();
+        }
+        REQUIRE(drawn == expected);
+    }
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch.hpp>
+#include <vector>
+
+#include "../src/Philox.h"
+#include "../src/RandomBuffer.h"
+#include "../src/kiss.h"
+
+// known answers of Philox4x32-10 from the Random123 distribution
+TEST_CASE("Philox matches the reference vectors") {
+    PhiloxRNG rng;
+    unsigned int w[4];
+
+    rng.Init(0, 0);
+    rng.Block(0, w);
+    REQUIRE(w[0] == 0x6627e8d5u);
+    REQUIRE(w[1] == 0xe169c58du);
+    REQUIRE(w[2] == 0xbc57ac4cu);
+    REQUIRE(w[3] == 0x9b00dbd8u);
+
+    rng.Init(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+    rng.Block(0xffffffffffffffffULL, w);
+    REQUIRE(w[0] == 0x408f276du);
+    REQUIRE(w[1] == 0x41c83b0eu);
+    REQUIRE(w[2] == 0xa20bc7c6u);
+    REQUIRE(w[3] == 0x6d5451fdu);
+
+    // counter {243f6a88, 85a308d3, 13198a2e, 03707344} and key
+    // {a4093822, 299f31d0}, the digits of pi
+    rng.Init(0x299f31d0a4093822ULL, 0x0370734413198a2eULL);
+    rng.Block(0x85a308d3243f6a88ULL, w);
+    REQUIRE(w[0] == 0xd16cfe09u);
+    REQUIRE(w[1] == 0x94fdccebu);
+    REQUIRE(w[2] == 0x5001e420u);
+    REQUIRE(w[3] == 0x24126ea1u);
+}
+
+// the n-th number of a stream depends on the seed, the stream and n only
+TEST_CASE("Philox streams are reproducible in any order") {
+    PhiloxRNG a;
+    a.Init(8923052835283572ULL, 3);
+    std::vector<double> single(101);
+    for (int i = 0; i < 101; i++) {
+        single[i] = a.RandomUniformDbl();
+        REQUIRE(single[i] >= 0);
+        REQUIRE(single[i] < 1);
+    }
+
+    // block fills of odd and even lengths
+    PhiloxRNG b;
+    b.Init(8923052835283572ULL, 3);
+    std::vector<double> filled(101);
+    b.FillUniformDbl(filled.data(), 1);
+    b.FillUniformDbl(filled.data() + 1, 50);
+    b.FillUniformDbl(filled.data() + 51, 50);
+    REQUIRE(filled == single);
+    REQUIRE(b.GetPosition() == 101);
+
+    // jumping straight to a position
+    PhiloxRNG c;
+    c.Init(8923052835283572ULL, 3);
+    c.SetPosition(77);
+    REQUIRE(c.RandomUniformDbl() == single[77]);
+    REQUIRE(c.RandomUniformDbl() == single[78]);
+
+    // another stream of the same seed gives other numbers
+    PhiloxRNG d;
+    d.Init(8923052835283572ULL, 4);
+    REQUIRE(d.RandomUniformDbl() != single[0]);
+}
+
+// the default block fill of the interface is the single draws in a row
+TEST_CASE("KISS block fill follows the single draws") {
+    KISSRNG a;
+    KISSRNG b;
+    a.InitCold(8923052835283572);
+    b.InitCold(8923052835283572);
+
+    std::vector<double> filled(10);
+    RNG *rng = &b;
+    rng->FillUniformDbl(filled.data(), 10);
+    for (int i = 0; i < 10; i++) {
+        REQUIRE(filled[i] == a.RandomUniformDbl());
+    }
+}
+
+// drawing through the buffer gives the sequence of its source, over refills
+// and mixed with block fills
+TEST_CASE("buffered numbers follow the source") {
+    int n = 3 * RandomBuffer::block_size + 7;
+
+    KISSRNG kiss_ref;
+    KISSRNG kiss;
+    kiss_ref.InitCold(8923052835283572);
+    RandomBuffer buffer;
+    buffer.setSource(&kiss);
+    buffer.InitCold(8923052835283572);
+    for (int i = 0; i < n; i++) {
+        REQUIRE(buffer.RandomUniformDbl() == kiss_ref.RandomUniformDbl());
+    }
+    std::vector<double> filled(n);
+    buffer.FillUniformDbl(filled.data(), n);
+    for (int i = 0; i < n; i++) {
+        REQUIRE(filled[i] == kiss_ref.RandomUniformDbl());
+    }
+
+    // the vectorized philox fill against the blocks one at a time
+    PhiloxRNG philox_ref;
+    PhiloxRNG philox;
+    philox_ref.Init(8923052835283572ULL, 5);
+    buffer.setSource(&philox);
+    philox.Init(8923052835283572ULL, 5);
+    for (int i = 0; i < n; i++) {
+        REQUIRE(buffer.RandomUniformDbl() == philox_ref.RandomUniformDbl());
+    }
+
+    // after a reseed the buffered numbers are gone
+    philox.Init(8923052835283572ULL, 5);
+    buffer.discard();
+    philox_ref.SetPosition(0);
+    REQUIRE(buffer.RandomUniformDbl() == philox_ref.RandomUniformDbl());
+}
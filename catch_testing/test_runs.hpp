@@ -0,0 +1,54 @@
+#ifndef TEST_RUNS_HPP
+#define TEST_RUNS_HPP
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/Parameters.h"
+#include "../src/Simulation.h"
+
+// the output prefix name in the temporary directory
+std::string temp_prefix(std::string name) {
+    return std::string(P_tmpdir) + "/" + name;
+}
+
+// the whole contents of the named files of the output prefix
+std::vector<std::string> read_files(std::string prefix,
+                                    std::vector<std::string> names) {
+    std::vector<std::string> contents;
+    for (std::string name : names) {
+        std::ifstream file(prefix + name, std::ios::binary);
+        std::stringstream text;
+        text << file.rdbuf();
+        contents.push_back(text.str());
+    }
+    return contents;
+}
+
+// runs the sweeps first_sweep to first_sweep + n_sweeps - 1 of the run of
+// param and returns the contents of the named files it wrote, once the run
+// is finished and its files are closed. each_sweep, if given, is called with
+// the simulation after every sweep
+std::vector<std::string>
+run_to_files(std::string yaml, Parameters param, int first_sweep,
+             int n_sweeps, std::vector<std::string> names,
+             std::function<void(Simulation *, int)> each_sweep = nullptr) {
+    {
+        Simulation sim(yaml, param);
+        sim.setQuiet(true);
+        sim.initializeRun();
+        for (int s = first_sweep; s < first_sweep + n_sweeps; s++) {
+            sim.runSweep(s);
+            if (each_sweep) {
+                each_sweep(&sim, s);
+            }
+        }
+        sim.finishRun();
+    }
+    return read_files(param.getOutputPrefix(), names);
+}
+#endif
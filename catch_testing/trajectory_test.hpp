@@ -0,0 +1,148 @@
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/Parameters.h"
+#include "../src/ParticleStore.h"
+#include "../src/Trajectory.h"
+#include "test_runs.hpp"
+
+// three frames of five particles in the given precision
+std::string write_test_trajectory(int precision) {
+    std::string path = std::string(P_tmpdir) + "/trajectory" +
+                       std::to_string(precision) + ".bin";
+    int types[5] = {1, 2, 2, 1, 2};
+    std::vector<double> x(5);
+    std::vector<double> y(5);
+
+    TrajectoryWriter writer;
+    REQUIRE(writer.open(path, 5, precision, 7.5, 1234567890123ULL, types));
+    for (int f = 0; f < 3; f++) {
+        for (int k = 0; k < 5; k++) {
+            x[k] = 0.1 * k + f;
+            y[k] = -0.3 * k - f;
+        }
+        writer.writeFrame(100 * (f + 1), x.data(), y.data());
+    }
+    writer.close();
+    REQUIRE(writer.getNumFrames() == 3);
+    return path;
+}
+
+TEST_CASE("Binary trajectories read back through the mapping") {
+    for (int precision : {8, 4}) {
+        std::string path = write_test_trajectory(precision);
+
+        TrajectoryReader reader;
+        REQUIRE(reader.open(path));
+        REQUIRE(reader.getNumParticles() == 5);
+        REQUIRE(reader.getPrecision() == precision);
+        REQUIRE(reader.getBoxLength() == 7.5);
+        REQUIRE(reader.getParamsHash() == 1234567890123ULL);
+        REQUIRE(reader.getNumFrames() == 3);
+        REQUIRE(reader.getTypes()[1] == 2);
+        REQUIRE(reader.getTypes()[3] == 1);
+        REQUIRE((reader.getFrame(0) != nullptr) == (precision == 8));
+
+        ParticleStore particles;
+        particles.resize(5);
+        for (int f = 0; f < 3; f++) {
+            REQUIRE(reader.getSweep(f) == 100 * (f + 1));
+            reader.readFrame(f, &particles);
+            for (int k = 0; k < 5; k++) {
+                // float32 keeps about seven digits
+                double x = 0.1 * k + f;
+                double y = -0.3 * k - f;
+                if (precision == 8) {
+                    REQUIRE(particles.getX_Position(k) == x);
+                    REQUIRE(particles.getY_Position(k) == y);
+                } else {
+                    REQUIRE(particles.getX_Position(k) == Approx(x));
+                    REQUIRE(particles.getY_Position(k) == Approx(y));
+                }
+            }
+        }
+        REQUIRE(particles.getType(4) == 2);
+
+        // a frame cut short is left out
+        reader.close();
+        std::ofstream tail(path, std::ios::binary | std::ios::app);
+        tail << "partial";
+        tail.close();
+        REQUIRE(reader.open(path));
+        REQUIRE(reader.getNumFrames() == 3);
+    }
+
+    TrajectoryReader reader;
+    REQUIRE_FALSE(reader.open("catch_testing/test_params.yaml"));
+    REQUIRE_FALSE(reader.open(std::string(P_tmpdir) + "/no_such_file.bin"));
+
+    // damaged headers: no particles, or too short for the particle types
+    std::string path = write_test_trajectory(8);
+    std::string damaged = std::string(P_tmpdir) + "/damaged.bin";
+    for (int k = 0; k < 3; k++) {
+        std::string bytes = read_files(path, {""})[0];
+        TrajectoryHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (k == 0) {
+            header.n_particles = 0;
+        } else if (k == 1) {
+            header.n_particles = -5;
+        } else {
+            header.header_size = sizeof(header) + 4 * 5 - 1;
+        }
+        std::memcpy(&bytes[0], &header, sizeof(header));
+        std::ofstream out(damaged, std::ios::binary);
+        out << bytes;
+        out.close();
+        REQUIRE_FALSE(reader.open(damaged));
+    }
+}
+
+TEST_CASE("The physics hash ignores how the run is carried out") {
+    Parameters param;
+    param.initializeParameters("catch_testing/energy_params.yaml");
+    unsigned long long hash = param.getPhysicsHash();
+
+    param.setStream(3);
+    param.setOutputPrefix("chain3_");
+    param.setSampleThreads(2);
+    REQUIRE(param.getPhysicsHash() == hash);
+
+    param.setRedTemp(param.getRedTemp() + 0.1);
+    REQUIRE(param.getPhysicsHash() != hash);
+}
+
+TEST_CASE("The trajectory holds the positions of positions.txt") {
+    std::string yaml = "catch_testing/energy_params.yaml";
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setTrajectoryFormat(1);
+    std::string prefix = temp_prefix("traj_run_");
+    param.setOutputPrefix(prefix);
+    run_to_files(yaml, param, param.getEq_sweep() + 1, 200, {});
+
+    // the same run written as text, by the pipeline test
+    std::string text =
+        analysed_files(yaml, 0, 200, {"positions.txt"})[0];
+    std::stringstream lines(text);
+
+    TrajectoryReader reader;
+    REQUIRE(reader.open(prefix + "trajectory.bin"));
+    REQUIRE(reader.getNumFrames() == 4);
+    REQUIRE(reader.getParamsHash() == param.getPhysicsHash());
+    for (long f = 0; f < reader.getNumFrames(); f++) {
+        REQUIRE(reader.getSweep(f) % param.getData_interval() == 0);
+        for (int k = 0; k < reader.getNumParticles(); k++) {
+            double x = 0;
+            double y = 0;
+            lines >> x >> y;
+            REQUIRE(reader.getX_Position(f, k) == Approx(x).epsilon(1e-5));
+            REQUIRE(reader.getY_Position(f, k) == Approx(y).epsilon(1e-5));
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#include <catch2/catch.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include "../src/Boundary.h"
+#include "../src/ClusterMove.h"
+#include "../src/EnergyTracker.h"
+#include "../src/Interaction.h"
+#include "../src/Parameters.h"
+#include "../src/ParticleStore.h"
+#include "../src/kiss.h"
+
+// the pairs across the edge of every accepted cluster move add up to the
+// change in the total energy
+TEST_CASE("Cluster moves keep the running energy up to date") {
+    static Parameters param;
+    param.initializeParameters("catch_testing/energy_params.yaml");
+
+    KISSRNG rng;
+    rng.InitCold(param.getSeed());
+
+    ParticleStore particles;
+    prepare_lattice(&particles, &param, &rng);
+    for (int k = 0; k < particles.size(); k++) {
+        particles.setStepWeight(k, 0.3);
+    }
+
+    Interaction interact;
+    interact.initializeInteraction(&param);
+    interact.buildNeighborLists(&particles);
+    Boundary bound;
+    bound.initializeBoundary(&param);
+
+    EnergyTracker energy;
+    energy.initializeEnergyTracker(&param);
+    energy.reset(&interact, &particles);
+
+    ClusterMove cluster;
+    cluster.initializeClusterMove(&param);
+    REQUIRE(cluster.isActive());
+
+    for (int k = 0; k < 2000; k++) {
+        cluster.attempt(&particles, &interact, &bound, &energy, &rng);
+    }
+    REQUIRE(cluster.getNumAccepts() > 0);
+    REQUIRE(cluster.getAvgSize() > 1);
+
+    std::vector<double> expected(particles.size());
+    double total = interact.totalEnergy(&particles, expected.data());
+    REQUIRE(energy.getTotal() == Approx(total).margin(1e-8));
+    for (int k = 0; k < particles.size(); k++) {
+        REQUIRE(energy.getParticleEnergy(k) ==
+                Approx(expected[k]).margin(1e-8));
+    }
+}
@@ -0,0 +1,82 @@
+# scaling of the threaded property sampling: runs ./sim on periodic systems of
+# 10^3, 10^4 and 10^5 particles with 0 (the serial loops), 1, 2, 4 ...
+# sample threads and prints the seconds per sample of the number densities,
+# energy and virial and the speedup over the serial loops. the sampling visits
+# every pair, so 10^5 particles take a while per sample. run from the
+# repository root after building
+#
+#   python3 sample_scaling.py [max threads] [particles ...]
+
+import os
+import subprocess
+import sys
+
+max_threads = int(sys.argv[1]) if len(sys.argv) > 1 else 4
+sizes = [int(n) for n in sys.argv[2:]] or [1000, 10000, 100000]
+
+run_dir = 'scaling_run'
+
+# two sweeps and a single sample after the first one
+params = """totalParticles  : {n}
+type1_Particles : {half}
+type2_Particles : {rest}
+particleRadius  : .2
+
+reducedTemp : 1.0
+reducedDens : .7
+sigma       : 1
+boxLength   : 0
+
+reference_affinity : 2
+affinity_multiple  : 8
+
+seed   : 8923052835283572
+weight : .06
+
+initializationType : 1
+interactionType    : 2
+boundaryType       : 1
+
+numberUpdates         : 2
+equilibriate_sweep    : 0
+data_collect_interval : 1
+
+springConstant : 1.0
+rest_length    : 2.0
+
+external_well_depth : 1.3
+animationFile : positions.txt
+
+sample_threads : {threads}
+"""
+
+
+def seconds_per_sample(n_particles, threads):
+    yaml = os.path.join(run_dir, 'sampling.yaml')
+    with open(yaml, 'w') as f:
+        f.write(params.format(n=n_particles, half=n_particles // 2,
+                              rest=n_particles - n_particles // 2,
+                              threads=threads))
+    out = subprocess.check_output([os.path.abspath('sim'), 'sampling.yaml'],
+                                  cwd=run_dir).decode()
+    for line in out.splitlines():
+        if line.endswith('seconds each'):
+            return float(line.split()[3])
+    return 0
+
+
+if not os.path.isdir(run_dir):
+    os.mkdir(run_dir)
+
+for n_particles in sizes:
+    print('WCA potential, {} particles'.format(n_particles))
+    print('threads  s/sample  speedup')
+    base = seconds_per_sample(n_particles, 0)
+    print('{:>7}  {:8.3f}  {:7.2f}'.format('serial', base, 1.0))
+    threads = 1
+    while threads <= max_threads:
+        seconds = seconds_per_sample(n_particles, threads)
+        print('{:7d}  {:8.3f}  {:7.2f}'.format(threads, seconds,
+                                               base / seconds))
+        threads = threads * 2
+    print('')
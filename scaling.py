@@ -0,0 +1,87 @@
+# strong scaling of the checkerboard sweep: runs ./sim on one large periodic
+# system with 1, 2, 4, ... 64 sweep threads, for the WCA and the WCA + spring
+# potentials, and prints the sweeps per second and the speedup over one
+# thread. the spring is cut off at 8 sigma, where it has decayed to e^-18,
+# since without a cutoff there are no cells to split the box into. every run
+# still writes the number density files, which for 10^5 particles takes
+# longer than the sweeps. run from the repository root after building
+#
+#   python3 scaling.py [particles] [sweeps] [max threads]
+
+import os
+import subprocess
+import sys
+
+n_particles = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+n_sweeps = int(sys.argv[2]) if len(sys.argv) > 2 else 20
+max_threads = int(sys.argv[3]) if len(sys.argv) > 3 else 64
+
+run_dir = 'scaling_run'
+
+# no data is collected (equilibriate_sweep = numberUpdates), so only the
+# sweeps themselves are timed
+params = """totalParticles  : {n}
+type1_Particles : {half}
+type2_Particles : {rest}
+particleRadius  : .2
+
+reducedTemp : 1.0
+reducedDens : .7
+sigma       : 1
+boxLength   : 0
+
+reference_affinity : 2
+affinity_multiple  : 8
+
+seed   : 8923052835283572
+weight : .06
+
+initializationType : 1
+interactionType    : {interaction}
+boundaryType       : 1
+
+numberUpdates         : {sweeps}
+equilibriate_sweep    : {sweeps}
+data_collect_interval : {sweeps}
+
+springConstant : 1.0
+rest_length    : 2.0
+spring_cutoff  : 8
+
+external_well_depth : 1.3
+animationFile : positions.txt
+
+sweep_threads : {threads}
+"""
+
+
+def sweeps_per_second(interaction, threads):
+    yaml = os.path.join(run_dir, 'scaling.yaml')
+    with open(yaml, 'w') as f:
+        f.write(params.format(n=n_particles, half=n_particles // 2,
+                              rest=n_particles - n_particles // 2,
+                              interaction=interaction, sweeps=n_sweeps,
+                              threads=threads))
+    out = subprocess.check_output([os.path.abspath('sim'), 'scaling.yaml'],
+                                  cwd=run_dir).decode()
+    for line in out.splitlines():
+        if line.endswith('sweeps per second'):
+            return float(line.split()[0])
+    return 0
+
+
+if not os.path.isdir(run_dir):
+    os.mkdir(run_dir)
+
+for name, interaction in [('WCA', 2), ('WCA + spring', 3)]:
+    print('{} potential, {} particles'.format(name, n_particles))
+    print('threads  sweeps/s  speedup')
+    base = 0
+    threads = 1
+    while threads <= max_threads:
+        rate = sweeps_per_second(interaction, threads)
+        if threads == 1:
+            base = rate
+        print('{:7d}  {:8.3f}  {:7.2f}'.format(threads, rate, rate / base))
+        threads = threads * 2
+    print('')
@@ -0,0 +1,14 @@
+#ifndef ALLOCCOUNTER_H
+#define ALLOCCOUNTER_H
+
+/* HEAP ALLOCATION COUNTER
+ * BUILT WITH COUNT_ALLOCATIONS (cmake -DCOUNT_ALLOCATIONS=ON, ALWAYS ON FOR
+ * THE TESTS) THE GLOBAL operator new COUNTS EVERY ALLOCATION OF THE PROGRAM.
+ * AFTER STARTUP A SWEEP SHOULD NOT ALLOCATE AT ALL, SO THE COUNT BEFORE AND
+ * AFTER A NUMBER OF SWEEPS CATCHES ANY ALLOCATION THAT CREEPS INTO THE MOVES
+ * OR THE PROPERTY SAMPLING
+ */
+
+// allocations so far, or -1 if the counter is not built in
+long long allocationCount();
+#endif
@@ -0,0 +1,139 @@
+#include <algorithm>
+
+#include "AnalysisPipeline.h"
+
+void AnalysisPipeline::initializeAnalysisPipeline(
+    int n_buffer, int n_particles, bool energies,
+    std::function<void(const Snapshot &)> f) {
+    n_slots = n_buffer;
+    if (n_slots <= 0) {
+        n_slots = 0;
+        return;
+    }
+    analyse = f;
+    stop = false;
+
+    // every slot is allocated once, so a push only copies
+    slots.resize(n_slots);
+    for (int s = 0; s < n_slots; s++) {
+        slots[s].x_position.resize(n_particles);
+        slots[s].y_position.resize(n_particles);
+        slots[s].type.resize(n_particles);
+        if (energies) {
+            slots[s].energy.resize(n_particles);
+        }
+    }
+    consumer = std::thread(&AnalysisPipeline::work, this);
+}
+
+bool AnalysisPipeline::isActive() { return n_slots > 0; }
+
+// the slow path of a push: the analysis thread may be asleep on an empty ring
+void AnalysisPipeline::wakeConsumer() {
+    if (consumer_waiting) {
+        std::lock_guard<std::mutex> guard(lock);
+        not_empty.notify_one();
+    }
+}
+
+void AnalysisPipeline::push(int sweep, const ParticleStore *particles,
+                            const double *energies) {
+    long h = head.load(std::memory_order_relaxed); // only written here
+    int occupancy = int(h - tail);
+
+    n_pushes++;
+    sum_occupancy = sum_occupancy + occupancy;
+    max_occupancy = std::max(max_occupancy, occupancy);
+
+    // the chain only stops here, until the analysis frees the oldest slot
+    if (occupancy == n_slots) {
+        n_full++;
+        std::chrono::steady_clock::time_point wait_start =
+            std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> guard(lock);
+        producer_waiting = true;
+        not_full.wait(guard, [&]() { return h - tail < n_slots; });
+        producer_waiting = false;
+        blocked_time = blocked_time + (std::chrono::steady_clock::now() -
+                                       wait_start);
+    }
+
+    Snapshot *s = &slots[h % n_slots];
+    int n = particles->size();
+    s->sweep = sweep;
+    std::copy(particles->getX_Positions(), particles->getX_Positions() + n,
+              s->x_position.begin());
+    std::copy(particles->getY_Positions(), particles->getY_Positions() + n,
+              s->y_position.begin());
+    std::copy(particles->getTypes(), particles->getTypes() + n,
+              s->type.begin());
+    if (!s->energy.empty()) {
+        std::copy(energies, energies + n, s->energy.begin());
+    }
+
+    head = h + 1; // hands the slot over to the analysis
+    wakeConsumer();
+}
+
+void AnalysisPipeline::work() {
+    while (true) {
+        long t = tail.load(std::memory_order_relaxed); // only written here
+        if (head == t) {
+            std::unique_lock<std::mutex> guard(lock);
+            consumer_waiting = true;
+            not_empty.wait(guard, [&]() { return head != t || stop; });
+            consumer_waiting = false;
+            if (head == t) {
+                return; // stopped, with nothing left to analyse
+            }
+        }
+
+        analyse(slots[t % n_slots]);
+
+        tail = t + 1; // the slot is free again
+        if (producer_waiting) {
+            std::lock_guard<std::mutex> guard(lock);
+            not_full.notify_one();
+        }
+    }
+}
+
+// the chain waits as it does on a full ring, woken by the same notify
+void AnalysisPipeline::drain() {
+    if (!consumer.joinable()) {
+        return;
+    }
+    long h = head.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> guard(lock);
+    producer_waiting = true;
+    not_full.wait(guard, [&]() { return tail == h; });
+    producer_waiting = false;
+}
+
+void AnalysisPipeline::finish() {
+    if (!consumer.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+        not_empty.notify_one();
+    }
+    consumer.join();
+}
+
+AnalysisPipeline::~AnalysisPipeline() { finish(); }
+
+int AnalysisPipeline::getNumSlots() { return n_slots; }
+long AnalysisPipeline::getNumPushes() { return n_pushes; }
+long AnalysisPipeline::getNumFull() { return n_full; }
+
+double AnalysisPipeline::getAvgOccupancy() {
+    if (n_pushes == 0) {
+        return 0;
+    }
+    return sum_occupancy / n_pushes;
+}
+
+int AnalysisPipeline::getMaxOccupancy() { return max_occupancy; }
+double AnalysisPipeline::getBlockedTime() { return blocked_time.count(); }
@@ -0,0 +1,91 @@
+#ifndef ANALYSISPIPELINE_H
+#define ANALYSISPIPELINE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ParticleStore.h"
+
+// one sample of the chain: the configuration and, if they are tracked, the
+// energies of the particles
+struct Snapshot {
+    int sweep = 0;
+    std::vector<double> x_position;
+    std::vector<double> y_position;
+    std::vector<int> type;
+    std::vector<double> energy; // empty unless per_particle_energy is on
+};
+
+/* ASYNCHRONOUS ANALYSIS OF THE SAMPLES
+ * AT SAMPLE TIME THE CHAIN COPIES ITS CONFIGURATION INTO THE NEXT FREE SLOT
+ * OF A RING OF analysis_buffer PREALLOCATED SNAPSHOTS AND GOES ON WITH THE
+ * NEXT SWEEP. AN ANALYSIS THREAD TAKES THE SNAPSHOTS OUT IN THE ORDER THEY
+ * WERE TAKEN AND HANDS THEM TO THE ANALYSIS (WRITING THE POSITIONS AND THE
+ * PROPERTY PASS, WHICH MAY ITSELF USE sample_threads), SO THE OUTPUT IS THE
+ * SAME AS SAMPLING ON THE CHAIN. THE RING HAS ONE PRODUCER AND ONE CONSUMER
+ * AND IS PASSED BY TWO ATOMIC COUNTERS ALONE; THE MUTEX IS ONLY TAKEN TO
+ * SLEEP WHEN THE RING IS FULL (THE CHAIN) OR EMPTY (THE ANALYSIS)
+ */
+class AnalysisPipeline {
+
+  private:
+    std::vector<Snapshot> slots;
+    int n_slots = 0; // 0 = the chain analyses its own samples
+
+    std::atomic<long> head{0}; // snapshots pushed by the chain
+    std::atomic<long> tail{0}; // snapshots analysed
+    std::atomic<bool> producer_waiting{false};
+    std::atomic<bool> consumer_waiting{false};
+    std::atomic<bool> stop{false};
+
+    std::mutex lock;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    std::thread consumer;
+
+    std::function<void(const Snapshot &)> analyse;
+
+    // occupancy of the ring seen by the chain at every push
+    long n_pushes = 0;
+    long n_full = 0; // pushes that had to wait for a free slot
+    double sum_occupancy = 0;
+    int max_occupancy = 0;
+    std::chrono::duration<double> blocked_time{0};
+
+    void work();
+    void wakeConsumer();
+
+  public:
+    AnalysisPipeline() = default;
+    AnalysisPipeline(const AnalysisPipeline &) = delete;
+    AnalysisPipeline &operator=(const AnalysisPipeline &) = delete;
+    ~AnalysisPipeline();
+
+    // n_buffer snapshots of n_particles, with the energies if energies is
+    // set. starts the analysis thread, which calls f on every snapshot
+    void initializeAnalysisPipeline(int n_buffer, int n_particles,
+                                    bool energies,
+                                    std::function<void(const Snapshot &)> f);
+    bool isActive();
+
+    // copies the configuration into the ring, waiting if it is full
+    void push(int sweep, const ParticleStore *particles,
+              const double *energies);
+    // waits until every snapshot pushed so far has been analysed, leaving
+    // the analysis thread running (drain) or stopping it (finish)
+    void drain();
+    void finish();
+
+    int getNumSlots();
+    long getNumPushes();
+    long getNumFull();
+    double getAvgOccupancy();
+    int getMaxOccupancy();
+    double getBlockedTime();
+};
+#endif
@@ -0,0 +1,89 @@
+#include <cmath>
+
+#include "BlockAverage.h"
+
+void BlockAverage::add(double x) {
+    sum = sum + x;
+
+    // every second value of a level completes a block of the next one
+    for (int l = 0; l < max_levels; l++) {
+        Level *level = &levels[l];
+        level->n++;
+        double delta = x - level->mean;
+        level->mean = level->mean + delta / level->n;
+        level->m2 = level->m2 + delta * (x - level->mean);
+
+        if (!level->has_pending) {
+            level->pending = x;
+            level->has_pending = true;
+            return;
+        }
+        x = 0.5 * (level->pending + x);
+        level->has_pending = false;
+    }
+}
+
+long BlockAverage::getCount() { return levels[0].n; }
+
+double BlockAverage::getMean() {
+    if (levels[0].n == 0) {
+        return 0;
+    }
+    return sum / levels[0].n;
+}
+
+double BlockAverage::getVariance() {
+    if (levels[0].n < 2) {
+        return 0;
+    }
+    return levels[0].m2 / (levels[0].n - 1);
+}
+
+// the naive standard error of the mean of the blocks of level l
+double BlockAverage::levelError(int l) {
+    double n = levels[l].n;
+    return sqrt(levels[l].m2 / (n * (n - 1)));
+}
+
+int BlockAverage::getBlockLevel() {
+    if (levels[0].n < 2) {
+        return -1;
+    }
+    double error_0 = levelError(0);
+    if (error_0 == 0) {
+        return 0; // a constant series
+    }
+
+    double n = levels[0].n;
+    for (int l = 0; l < max_levels && levels[l].n >= 2; l++) {
+        double block = pow(2.0, l);
+        double ratio = levelError(l) / error_0;
+        if (block * block * block > 2 * n * pow(ratio, 4)) {
+            return l;
+        }
+    }
+    return -1;
+}
+
+double BlockAverage::getStdError() {
+    int l = getBlockLevel();
+    if (l < 0) {
+        // not converged: the longest blocks there are
+        l = max_levels - 1;
+        while (l > 0 && levels[l].n < 2) {
+            l--;
+        }
+        if (levels[l].n < 2) {
+            return 0;
+        }
+    }
+    return levelError(l);
+}
+
+double BlockAverage::getTauInt() {
+    if (levels[0].n < 2 || levelError(0) == 0) {
+        return 0.5;
+    }
+    double ratio = getStdError() / levelError(0);
+    return 0.5 * ratio * ratio;
+}
@@ -0,0 +1,48 @@
+#ifndef BLOCKAVERAGE_H
+#define BLOCKAVERAGE_H
+
+/* STREAMING MEAN AND ERROR OF A CORRELATED SERIES
+ * THE SAMPLES OF A MARKOV CHAIN ARE CORRELATED, SO THE NAIVE STANDARD ERROR
+ * OF THEIR MEAN IS TOO SMALL. FOLLOWING FLYVBJERG AND PETERSEN, LEVEL l HOLDS
+ * THE SERIES AVERAGED OVER BLOCKS OF 2^l SAMPLES, EACH BUILT FROM PAIRS OF
+ * THE LEVEL BELOW AS THE SAMPLES ARRIVE, AND KEEPS ITS MEAN AND VARIANCE
+ * WITH WELFORD'S UPDATE. THE ERROR ESTIMATE GROWS WITH THE BLOCK SIZE UNTIL
+ * THE BLOCKS ARE LONGER THAN THE CORRELATION TIME; THE BLOCK SIZE IS CHOSEN
+ * WITH THE CRITERION OF LEE, NEEDS AND DRUMMOND (B^3 > 2 N (s_B / s_1)^4).
+ * THE MEMORY IS FIXED, WHATEVER THE LENGTH OF THE RUN
+ */
+class BlockAverage {
+
+  private:
+    static const int max_levels = 48; // blocks of up to 2^47 samples
+
+    struct Level {
+        long n = 0;
+        double mean = 0;
+        double m2 = 0; // sum of the squared deviations from the mean
+        double pending = 0; // first half of the next block, if any
+        bool has_pending = false;
+    };
+    Level levels[max_levels];
+    double sum = 0; // the mean is sum / n, as summing the whole series gives
+
+    double levelError(int l);
+
+  public:
+    void add(double x);
+
+    long getCount();
+    double getMean();
+    double getVariance();
+
+    // the block level where the error stops growing, -1 if the run is too
+    // short for any of them
+    int getBlockLevel();
+    // standard error of the mean at that level (the largest level with two
+    // blocks if none is long enough)
+    double getStdError();
+    // integrated autocorrelation time in samples, from the ratio of the
+    // blocked to the naive variance of the mean (1/2 if uncorrelated)
+    double getTauInt();
+};
+#endif
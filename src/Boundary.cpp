@@ -9,21 +9,17 @@ double dist_part(double x1, double x2, double y1, double y2) {
     return sqrt((x2 - x1) * (x2 - x1) + (y2 - y1) * (y2 - y1));
 }
 
-bool Boundary::rigidBoundary(std::vector<Particle> *particles, int index) {
-
-    Particle current_prt;
+bool Boundary::rigidBoundary(ParticleStore *particles, int index) {
 
     double x_wall = 0;
     double y_wall = 0;
     double num = 0;
 
-    current_prt = (*particles)[index];
-
     // reads in the current x,y trial position and the radius of the trial
     // particle
-    double x_temp = current_prt.getX_TrialPos();
-    double y_temp = current_prt.getY_TrialPos();
-    double rad_temp = current_prt.getRadius();
+    double x_temp = particles->getX_TrialPos(index);
+    double y_temp = particles->getY_TrialPos(index);
+    double rad_temp = particles->getRadius(index);
 
     bool accept = 1;
 
@@ -67,9 +63,7 @@ bool Boundary::rigidBoundary(std::vector<Particle> *particles, int index) {
     return accept;
 }
 
-void Boundary::periodicBoundary(std::vector<Particle> *particles, int index) {
-
-    Particle current_prt;
+void Boundary::periodicBoundary(ParticleStore *particles, int index) {
 
     double x_wall = 0;
     double y_wall = 0;
@@ -81,16 +75,14 @@ void Boundary::periodicBoundary(std::vector<Particle> *particles, int index) {
 
     double wallBound = 0.5 * boxLength;
 
-    current_prt = (*particles)[index];
-
     // sets the current particle's x,y sets the current particle's x,y position
-    double x_curr = current_prt.getX_Position();
-    double y_curr = current_prt.getY_Position();
+    double x_curr = particles->getX_Position(index);
+    double y_curr = particles->getY_Position(index);
 
     // set the x,y trial position for current particle
-    double x_temp = current_prt.getX_TrialPos();
-    double y_temp = current_prt.getY_TrialPos();
-    double rad_temp = current_prt.getRadius();
+    double x_temp = particles->getX_TrialPos(index);
+    double y_temp = particles->getY_TrialPos(index);
+    double rad_temp = particles->getRadius(index);
 
     /* FINDS THE NEAREST X,Y WALLS
      * IF THE PARTICLE HAS MOVED PAST THE NEAREST WALL, COMPUTE THE DISTANCE
@@ -142,23 +134,17 @@ void Boundary::periodicBoundary(std::vector<Particle> *particles, int index) {
         }
     }
 
-    current_prt.setX_TrialPos(x_temp); // puts the updated particle with updated
-    current_prt.setY_TrialPos(y_temp); // trial positions back into the array
-
-    (*particles)[index] = current_prt;
+    particles->setX_TrialPos(index, x_temp); // stores the updated trial
+    particles->setY_TrialPos(index, y_temp); // positions
 }
 
-double Boundary::externalWell(std::vector<Particle> *particles, int index) {
+double Boundary::externalWell(ParticleStore *particles, int index) {
 
-    Particle current_prt;
-
-    current_prt = (*particles)[index]; // assign current particle
-
-    double x_temp = current_prt.getX_TrialPos(); // assign the current and trial
-    double y_temp = current_prt.getY_TrialPos(); // positions and the radius of
-                                                 // the current particle
-    double x_curr = current_prt.getX_Position();
-    double y_curr = current_prt.getY_Position();
+    double x_temp = particles->getX_TrialPos(index); // assign the current and
+    double y_temp = particles->getY_TrialPos(index); // trial positions of the
+                                                     // current particle
+    double x_curr = particles->getX_Position(index);
+    double y_curr = particles->getY_Position(index);
 
     double energy_curr = ext_well_d * (pow(x_curr, 2) + pow(y_curr, 2));
     double energy_temp = ext_well_d * (pow(x_temp, 2) + pow(y_temp, 2));
@@ -168,11 +154,21 @@ double Boundary::externalWell(std::vector<Particle> *particles, int index) {
     return delta_energy;
 }
 
-void Boundary::initialPosition(std::vector<Particle> *particles,
-                               KISSRNG randVal) {
+// energy of all of the particles in the external well, 0 without one
+double Boundary::wellEnergy(ParticleStore *particles) {
+    if (bound_type != 2) {
+        return 0;
+    }
+    double energy = 0;
+    for (int k = 0; k < particles->size(); k++) {
+        energy = energy + ext_well_d * (pow(particles->getX_Position(k), 2) +
+                                        pow(particles->getY_Position(k), 2));
+    }
+    return energy;
+}
 
-    Particle current_prt;
-    Particle compare_prt;
+void Boundary::initialPosition(ParticleStore *particles,
+                               RNG *randVal) {
 
     double x_wall = 0;
     double y_wall = 0; // the locations of the nearest 'wall'
@@ -181,11 +177,10 @@ void Boundary::initialPosition(std::vector<Particle> *particles,
 
     for (int k = 0; k < n_particles; k++) {
 
-        current_prt = (*particles)[k];
-        double rad_temp = current_prt.getRadius();
+        double rad_temp = particles->getRadius(k);
 
-        double x_temp = randVal.RandomUniformDbl() * 0.5 * boxLength;
-        double y_temp = randVal.RandomUniformDbl() * 0.5 * boxLength;
+        double x_temp = randVal->RandomUniformDbl() * 0.5 * boxLength;
+        double y_temp = randVal->RandomUniformDbl() * 0.5 * boxLength;
 
         /* generate a random number from [0,1)
          * provides different 'quadrants' for the particle to be generated in
@@ -193,7 +188,7 @@ void Boundary::initialPosition(std::vector<Particle> *particles,
          */
 
         double wallbound = 0.5 * boxLength;
-        double num = randVal.RandomUniformDbl();
+        double num = randVal->RandomUniformDbl();
 
         if (k % 2 == 0 && num < .5) { // the acceptance presented in
             x_temp = -1 * x_temp; // 'check collision' is not implemented here
@@ -225,13 +220,10 @@ void Boundary::initialPosition(std::vector<Particle> *particles,
             accept = 0;
         } else if (k != 0) {
             for (int n = 0; n < k; n++) {
-                // assign comparison particle
-                compare_prt = (*particles)[n];
-
                 // assign the comparison x,y position and radius
-                double x_comp = compare_prt.getX_Position();
-                double y_comp = compare_prt.getY_Position();
-                double rad_comp = compare_prt.getRadius();
+                double x_comp = particles->getX_Position(n);
+                double y_comp = particles->getY_Position(n);
+                double rad_comp = particles->getRadius(n);
 
                 // if the distance between particles is less than the sum of the
                 // radii, reject position
@@ -244,20 +236,15 @@ void Boundary::initialPosition(std::vector<Particle> *particles,
         }
         // if position is accepted, assign the x,y position to current particle
         if (accept == 1) {
-            current_prt.setX_Position(x_temp);
-            current_prt.setY_Position(y_temp);
-
-            // put initialized particle into array
-            (*particles)[k] = current_prt;
+            particles->setX_Position(k, x_temp);
+            particles->setY_Position(k, y_temp);
         } else {
             k = k - 1; // generate a new random position for the same particle
         }
     }
 }
 
-int Boundary::initialHexagonal(std::vector<Particle> *particles) {
-
-    Particle prt;
+int Boundary::initialHexagonal(ParticleStore *particles) {
 
     int k = 0;
     int flag = 0;
@@ -275,8 +262,7 @@ int Boundary::initialHexagonal(std::vector<Particle> *particles) {
     if (interact_type != 0) { // this should be true for WCA and LJ
         x_dist = sigma;
     } else {
-        prt = (*particles)[0];
-        radius = prt.getRadius(); // if LJ != 1, use particle diameter
+        radius = particles->getRadius(0); // if LJ != 1, use particle diameter
         x_dist = 2 * radius;
     }
 
@@ -312,11 +298,8 @@ int Boundary::initialHexagonal(std::vector<Particle> *particles) {
         }                                           // at wall plus unit x_dist
 
         for (int n = 0; n < curr_row; n++) {
-            prt = (*particles)[k];
-            prt.setX_Position(x_init_dist + n * x_dist); // set x pos
-            prt.setY_Position(y_init_dist);              // set y pos
-
-            (*particles)[k] = prt;
+            particles->setX_Position(k, x_init_dist + n * x_dist); // x pos
+            particles->setY_Position(k, y_init_dist);              // y pos
             k++;
 
             if (k == n_particles) {
@@ -337,9 +320,7 @@ int Boundary::initialHexagonal(std::vector<Particle> *particles) {
     return return_num;
 }
 
-int Boundary::initialSquare(std::vector<Particle> *particles) {
-    Particle prt;
-
+int Boundary::initialSquare(ParticleStore *particles) {
     int k = 0;
     int flag = 0;
 
@@ -351,10 +332,8 @@ int Boundary::initialSquare(std::vector<Particle> *particles) {
         x_dist = sigma;
         y_dist = sigma;
     } else {
-        prt = (*particles)[0];
-
-        x_dist = 2 * prt.getRadius();
-        y_dist = 2 * prt.getRadius();
+        x_dist = 2 * particles->getRadius(0);
+        y_dist = 2 * particles->getRadius(0);
     }
 
     // determines the num of particles that fit into a single row
@@ -367,12 +346,9 @@ int Boundary::initialSquare(std::vector<Particle> *particles) {
     while (k < n_particles) {
 
         for (int n = 0; n < curr_row; n++) {
-            prt = (*particles)[k];
-
-            prt.setX_Position(x_init_dist + n * x_dist); // y pos stays the same
-            prt.setY_Position(y_init_dist);              // in for-loop while
-                                                         // x pos updates
-            (*particles)[k] = prt;
+            // y pos stays the same in for-loop while x pos updates
+            particles->setX_Position(k, x_init_dist + n * x_dist);
+            particles->setY_Position(k, y_init_dist);
             k++;
 
             if (k == n_particles) {
@@ -396,6 +372,7 @@ void Boundary::initializeBoundary(Parameters *p) {
     boxLength = p->getBoxLength();
     sigma = p->getSigma();
     interact_type = p->getInteract_Type();
+    bound_type = p->getBound_Type();
     n_particles = p->getNumParticles();
     ext_well_d = p->getExtWellDepth();
 }
@@ -4,8 +4,8 @@
 #include <vector>
 
 #include "Parameters.h"
-#include "Particle.h"
-#include "kiss.h"
+#include "ParticleStore.h"
+#include "RNG.h"
 
 class Boundary {
 
@@ -13,6 +13,7 @@ class Boundary {
     double boxLength = 0;
     double sigma = 0;
     int interact_type = 0;
+    int bound_type = 0;
     int n_particles = 0;
 
     double ext_well_d = 0;
@@ -20,12 +21,13 @@ class Boundary {
   public:
     void initializeBoundary(Parameters *p);
 
-    void initialPosition(std::vector<Particle> *particles, KISSRNG randVal);
-    int initialHexagonal(std::vector<Particle> *particles); // not random
-    int initialSquare(std::vector<Particle> *particles);
+    void initialPosition(ParticleStore *particles, RNG *randVal);
+    int initialHexagonal(ParticleStore *particles); // not random
+    int initialSquare(ParticleStore *particles);
 
-    void periodicBoundary(std::vector<Particle> *particles, int index);
-    bool rigidBoundary(std::vector<Particle> *particles, int index);
-    double externalWell(std::vector<Particle> *particles, int index);
+    void periodicBoundary(ParticleStore *particles, int index);
+    bool rigidBoundary(ParticleStore *particles, int index);
+    double externalWell(ParticleStore *particles, int index);
+    double wellEnergy(ParticleStore *particles);
 };
 #endif
@@ -0,0 +1,151 @@
+#include <cmath>
+
+#include "CellList.h"
+
+// returns the cell coordinate along one axis. positions outside of the box
+// (possible with the external well) are clamped into the edge cells, which
+// keeps neighbouring positions in neighbouring cells
+int CellList::cellCoord(double x) {
+    int c = int(floor((x + 0.5 * box_L) / cell_L));
+    if (c < 0) {
+        c = 0;
+    } else if (c >= n_cells) {
+        c = n_cells - 1;
+    }
+    return c;
+}
+
+int CellList::cellIndex(double x, double y) {
+    return cellCoord(x) * n_cells + cellCoord(y);
+}
+
+void CellList::insert(int index, int cell) {
+    prev[index] = -1;
+    next[index] = head[cell];
+    if (head[cell] != -1) {
+        prev[head[cell]] = index;
+    }
+    head[cell] = index;
+    cell_of[index] = cell;
+}
+
+void CellList::remove(int index) {
+    int cell = cell_of[index];
+    if (prev[index] != -1) {
+        next[prev[index]] = next[index];
+    } else {
+        head[cell] = next[index];
+    }
+    if (next[index] != -1) {
+        prev[next[index]] = prev[index];
+    }
+}
+
+void CellList::build(ParticleStore *particles) {
+    int n_particles = particles->size();
+
+    // the grid is only worth using if the 3x3 block is smaller than the box
+    active = n_cells >= 3;
+    if (!active) {
+        return;
+    }
+
+    head.assign(n_cells * n_cells, -1);
+    next.assign(n_particles, -1);
+    prev.assign(n_particles, -1);
+    cell_of.assign(n_particles, 0);
+
+    for (int k = 0; k < n_particles; k++) {
+        insert(k, cellIndex(particles->getX_Position(k),
+                            particles->getY_Position(k)));
+    }
+}
+
+// called once a trial move is accepted
+void CellList::moveParticle(int index, double x, double y) {
+    if (!active) {
+        return;
+    }
+    int cell = cellIndex(x, y);
+    if (cell != cell_of[index]) {
+        remove(index);
+        insert(index, cell);
+    }
+}
+
+int CellList::neighborCells(double x, double y, int *cells, double *shift_x,
+                            double *shift_y) {
+    int cx = cellCoord(x);
+    int cy = cellCoord(y);
+    int num = 0;
+
+    for (int dx = -1; dx <= 1; dx++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            int nx = cx + dx;
+            int ny = cy + dy;
+            double sx = 0;
+            double sy = 0;
+
+            if (periodic) {
+                // a cell past the right wall is the leftmost cell, whose
+                // particles are seen one box length to the right
+                if (nx < 0) {
+                    nx = nx + n_cells;
+                    sx = -box_L;
+                } else if (nx >= n_cells) {
+                    nx = nx - n_cells;
+                    sx = box_L;
+                }
+                if (ny < 0) {
+                    ny = ny + n_cells;
+                    sy = -box_L;
+                } else if (ny >= n_cells) {
+                    ny = ny - n_cells;
+                    sy = box_L;
+                }
+            } else if (nx < 0 || nx >= n_cells || ny < 0 || ny >= n_cells) {
+                continue;
+            }
+            cells[num] = nx * n_cells + ny;
+            shift_x[num] = sx;
+            shift_y[num] = sy;
+            num++;
+        }
+    }
+    return num;
+}
+
+bool CellList::isActive() { return active; }
+int CellList::getNumCells() { return n_cells; }
+int CellList::getCell(int index) { return cell_of[index]; }
+int CellList::getHead(int cell) { return head[cell]; }
+int CellList::getNext(int index) { return next[index]; }
+
+// the cutoff is given in absolute units (not r/sigma)
+void CellList::initializeCellList(Parameters *p, double cutoff) {
+    box_L = p->getBoxLength();
+    periodic = (p->getBound_Type() == 1);
+
+    n_cells = int(box_L / cutoff);
+    if (n_cells > 0) {
+        cell_L = box_L / n_cells;
+    }
+    active = false;
+}
+
+// active is only decided by the first build
+void CellList::saveState(CheckpointWriter *out) {
+    out->put(active);
+    out->putVector(head);
+    out->putVector(next);
+    out->putVector(prev);
+    out->putVector(cell_of);
+}
+
+void CellList::loadState(CheckpointReader *in) {
+    in->get(&active);
+    in->getVector(&head);
+    in->getVector(&next);
+    in->getVector(&prev);
+    in->getVector(&cell_of);
+}
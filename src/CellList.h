@@ -0,0 +1,55 @@
+#ifndef CELLLIST_H
+#define CELLLIST_H
+
+#include <vector>
+
+#include "Checkpoint.h"
+#include "Parameters.h"
+#include "ParticleStore.h"
+
+/* LINKED-CELL SPATIAL INDEX
+ * THE BOX IS DIVIDED INTO n_cells x n_cells SQUARE CELLS WHOSE WIDTH IS AT
+ * LEAST THE INTERACTION CUTOFF, SO EVERY PARTICLE WITHIN THE CUTOFF OF A
+ * POSITION LIES IN THE 3x3 BLOCK OF CELLS AROUND IT. THE PARTICLES OF A CELL
+ * ARE KEPT IN A DOUBLY LINKED LIST SO AN ACCEPTED MOVE IS AN O(1) UPDATE.
+ */
+class CellList {
+
+  private:
+    int n_cells = 0;    // number of cells along one side of the box
+    double cell_L = 0;  // width of a single cell
+    double box_L = 0;
+    bool periodic = false;
+    bool active = false;
+
+    std::vector<int> head;    // first particle in each cell, -1 if empty
+    std::vector<int> next;    // next/previous particle in the same cell
+    std::vector<int> prev;
+    std::vector<int> cell_of; // the cell each particle currently sits in
+
+    int cellCoord(double x);
+    void insert(int index, int cell);
+    void remove(int index);
+
+  public:
+    void initializeCellList(Parameters *p, double cutoff);
+    void build(ParticleStore *particles);
+    void moveParticle(int index, double x, double y);
+
+    bool isActive();
+    int getNumCells();
+    int cellIndex(double x, double y);
+    int getCell(int index);
+    int getHead(int cell);
+    int getNext(int index);
+
+    // fills the (up to 9) cells around x,y and the shift that has to be added
+    // to a particle position in that cell to get its nearest periodic image
+    int neighborCells(double x, double y, int *cells, double *shift_x,
+                      double *shift_y);
+
+    // the linked lists in their current order
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+};
+#endif
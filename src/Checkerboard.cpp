@@ -0,0 +1,178 @@
+#include <cmath>
+#include <functional>
+
+#include "Checkerboard.h"
+
+// shifts the domains by a random number of cells along x and y and finds the
+// domain of every column and row of cells
+void Checkerboard::placeDomains(RNG *rand) {
+    shift_x = int(rand->RandomUniformDbl() * n_cells);
+    shift_y = int(rand->RandomUniformDbl() * n_cells);
+
+    for (int i = 0; i < n_dom; i++) {
+        for (int c = bounds[i]; c < bounds[i + 1]; c++) {
+            dom_x[(c + shift_x) % n_cells] = i;
+            dom_y[(c + shift_y) % n_cells] = i;
+        }
+    }
+}
+
+// the particles in domain d, taken from its own cells only
+void Checkerboard::gather(int d, CellList *grid) {
+    int dx = d / n_dom;
+    int dy = d % n_dom;
+
+    members[d].clear();
+    for (int i = bounds[dx]; i < bounds[dx + 1]; i++) {
+        int cx = (i + shift_x) % n_cells;
+        for (int j = bounds[dy]; j < bounds[dy + 1]; j++) {
+            int cy = (j + shift_y) % n_cells;
+            for (int k = grid->getHead(cx * n_cells + cy); k != -1;
+                 k = grid->getNext(k)) {
+                members[d].push_back(k);
+            }
+        }
+    }
+}
+
+// the same metropolis moves as the serial sweep, confined to domain d
+void Checkerboard::sweepDomain(int d, ParticleStore *particles,
+                               Interaction *interact, Boundary *bound,
+                               EnergyTracker *energy) {
+    CellList *grid = interact->getCellList();
+    PhiloxRNG *rand = &streams[d];
+
+    gather(d, grid);
+    int n = members[d].size();
+
+    for (int m = 0; m < n; m++) {
+        int k = members[d][int(rand->RandomUniformDbl() * n)];
+
+        double x_trial = particles->x_trial(k, rand->RandomUniformDbl());
+        double y_trial = particles->y_trial(k, rand->RandomUniformDbl());
+        particles->setX_TrialPos(k, x_trial);
+        particles->setY_TrialPos(k, y_trial);
+        bound->periodicBoundary(particles, k);
+
+        int cell = grid->cellIndex(particles->getX_TrialPos(k),
+                                   particles->getY_TrialPos(k));
+        if (dom_x[cell / n_cells] * n_dom + dom_y[cell % n_cells] != d) {
+            ++rejects[d];
+            continue;
+        }
+
+        // the tail correction is part of the change in energy as it is for
+        // the serial sweep
+        double delta = interact->cellDelta(particles, k);
+        double delta_energy = delta + interact->getTailCorr();
+
+        if (delta_energy > 0 &&
+            rand->RandomUniformDbl() >= exp(-delta_energy / red_temp)) {
+            ++rejects[d];
+            continue;
+        }
+        energy->spreadMove(interact, particles, k);
+        particles->acceptTrial(k);
+        interact->updateCell(particles, k);
+        pair_delta[d] = pair_delta[d] + delta;
+    }
+}
+
+int Checkerboard::sweep(ParticleStore *particles, Interaction *interact,
+                        Boundary *bound, EnergyTracker *energy,
+                        RNG *rand) {
+    placeDomains(rand);
+
+    // a random order of the colours
+    int order[4] = {0, 1, 2, 3};
+    for (int i = 3; i > 0; i--) {
+        int j = int(rand->RandomUniformDbl() * (i + 1));
+        int tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    // the pool is handed a reference to the task, as a std::function would
+    // otherwise allocate a copy of the lambda for every colour
+    std::vector<int> *domains = nullptr;
+    auto task = [&](int n) {
+        sweepDomain((*domains)[n], particles, interact, bound, energy);
+    };
+    for (int i = 0; i < 4; i++) {
+        domains = &colours[order[i]];
+        pool.run(domains->size(), std::ref(task));
+    }
+
+    // added up in the same order whatever thread swept the domain
+    int n_rejects = 0;
+    for (int d = 0; d < n_dom * n_dom; d++) {
+        energy->addToTotal(pair_delta[d]);
+        n_rejects = n_rejects + rejects[d];
+        pair_delta[d] = 0;
+        rejects[d] = 0;
+    }
+    return n_rejects;
+}
+
+bool Checkerboard::isActive() { return active; }
+int Checkerboard::getNumThreads() { return pool.getNumThreads(); }
+int Checkerboard::getNumDomains() { return n_dom * n_dom; }
+
+void Checkerboard::saveState(CheckpointWriter *out) {
+    std::vector<unsigned long long> positions(streams.size());
+    for (int d = 0; d < int(streams.size()); d++) {
+        positions[d] = streams[d].GetPosition();
+    }
+    out->putVector(positions);
+}
+
+void Checkerboard::loadState(CheckpointReader *in) {
+    std::vector<unsigned long long> positions;
+    in->getVector(&positions);
+    if (positions.size() != streams.size()) {
+        return;
+    }
+    for (int d = 0; d < int(streams.size()); d++) {
+        streams[d].SetPosition(positions[d]);
+    }
+}
+
+void Checkerboard::initializeCheckerboard(Parameters *p,
+                                          Interaction *interact) {
+    int n_threads = p->getSweepThreads();
+    n_cells = interact->getCellList()->getNumCells();
+    red_temp = p->getRedTemp();
+
+    // two domains of at least two cells along each side
+    active = n_threads > 0 && p->getBound_Type() == 1 &&
+             p->getInteract_Type() != 0 && n_cells >= 4;
+    if (!active) {
+        return;
+    }
+
+    n_dom = 2 * (n_cells / 4);
+    bounds.resize(n_dom + 1);
+    for (int i = 0; i <= n_dom; i++) {
+        bounds[i] = i * n_cells / n_dom;
+    }
+    dom_x.assign(n_cells, 0);
+    dom_y.assign(n_cells, 0);
+
+    colours.assign(4, std::vector<int>());
+    for (int d = 0; d < n_dom * n_dom; d++) {
+        colours[(d / n_dom % 2) * 2 + d % n_dom % 2].push_back(d);
+    }
+
+    // the streams of the domains sit above the streams of the runs (replicas
+    // or chains), which are numbered from 0
+    streams.resize(n_dom * n_dom);
+    for (int d = 0; d < n_dom * n_dom; d++) {
+        unsigned long long run = p->getStream();
+        streams[d].Init(p->getSeed(), (run + 1) << 32 | d);
+    }
+    members.assign(n_dom * n_dom, std::vector<int>());
+    pair_delta.assign(n_dom * n_dom, 0);
+    rejects.assign(n_dom * n_dom, 0);
+
+    pool.initializeThreadPool(n_threads);
+}
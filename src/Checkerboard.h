@@ -0,0 +1,75 @@
+#ifndef CHECKERBOARD_H
+#define CHECKERBOARD_H
+
+#include <vector>
+
+#include "Boundary.h"
+#include "Checkpoint.h"
+#include "EnergyTracker.h"
+#include "Interaction.h"
+#include "Parameters.h"
+#include "ParticleStore.h"
+#include "ThreadPool.h"
+#include "Philox.h"
+#include "RNG.h"
+
+/* CHECKERBOARD SWEEP ON SEVERAL THREADS
+ * THE CELLS OF THE CELL LIST ARE GROUPED INTO AN EVEN NUMBER OF DOMAINS ALONG
+ * EACH SIDE OF THE BOX, EVERY DOMAIN AT LEAST TWO CELLS WIDE, AND THE DOMAINS
+ * ARE COLOURED LIKE A 2x2 CHECKERBOARD. TWO DOMAINS OF THE SAME COLOUR ARE
+ * SEPARATED BY A WHOLE DOMAIN OF ANOTHER COLOUR, WHICH IS WIDER THAN THE
+ * CUTOFF, SO THE DOMAINS OF ONE COLOUR CAN BE SWEPT AT THE SAME TIME. IN A
+ * DOMAIN EVERY PARTICLE THAT STARTED IN IT GETS ONE TRIAL MOVE ON AVERAGE,
+ * WITH A PHILOX STREAM OF ITS OWN, AND A MOVE THAT WOULD LEAVE THE
+ * DOMAIN IS REJECTED. THAT KEEPS EVERY MOVE SYMMETRIC, SO EACH COLOUR ON ITS
+ * OWN IS IN DETAILED BALANCE. THE COLOURS ARE SWEPT IN A RANDOM ORDER, WITH A
+ * BARRIER IN BETWEEN, AND THE DOMAINS ARE SHIFTED BY A RANDOM NUMBER OF CELLS
+ * EVERY SWEEP SO THAT THE PARTICLES CAN CROSS THEIR EDGES. THE RESULT DOES
+ * NOT DEPEND ON THE NUMBER OF THREADS. ONLY PERIODIC BOXES OF SOFT PARTICLES
+ * ARE SUPPORTED
+ */
+class Checkerboard {
+
+  private:
+    bool active = false;
+    int n_cells = 0;   // cells along one side of the box
+    int n_dom = 0;     // domains along one side, even
+    double red_temp = 0;
+
+    std::vector<int> bounds; // first cell of each domain, before the shift
+    int shift_x = 0;
+    int shift_y = 0;
+    std::vector<int> dom_x;  // domain of each column of cells for the shift
+    std::vector<int> dom_y;
+
+    std::vector<std::vector<int>> colours; // the domains of each colour
+    std::vector<PhiloxRNG> streams;        // one per domain
+    std::vector<std::vector<int>> members; // particles in each domain
+    std::vector<double> pair_delta;        // accepted change in pair energy
+    std::vector<int> rejects;
+
+    ThreadPool pool;
+
+    void placeDomains(RNG *rand);
+    void gather(int d, CellList *grid);
+    void sweepDomain(int d, ParticleStore *particles, Interaction *interact,
+                     Boundary *bound, EnergyTracker *energy);
+
+  public:
+    // the cell list of interact decides the size of the domains
+    void initializeCheckerboard(Parameters *p, Interaction *interact);
+
+    // one sweep, returns the number of rejected moves
+    int sweep(ParticleStore *particles, Interaction *interact,
+              Boundary *bound, EnergyTracker *energy, RNG *rand);
+
+    bool isActive();
+    int getNumThreads();
+    int getNumDomains();
+
+    // how far each domain is into its stream, the rest is drawn anew for
+    // every sweep
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+};
+#endif
@@ -0,0 +1,151 @@
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Checkpoint.h"
+
+static_assert(sizeof(CheckpointHeader) == 32,
+              "the header is written as it is laid out in memory");
+
+static const char checkpoint_magic[8] = "MCCHKP1";
+
+static std::uint64_t checksum(const char *bytes, std::size_t n) {
+    std::uint64_t h = 0xCBF29CE484222325ULL;
+    for (std::size_t i = 0; i < n; i++) {
+        h = (h ^ (unsigned char)bytes[i]) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+/////////////// WRITER ////////////////
+
+void CheckpointWriter::clear() { data.clear(); }
+
+void CheckpointWriter::putBytes(const void *bytes, std::size_t n) {
+    const char *b = (const char *)bytes;
+    data.insert(data.end(), b, b + n);
+}
+
+std::size_t CheckpointWriter::size() {
+    return sizeof(CheckpointHeader) + data.size();
+}
+
+bool CheckpointWriter::commit(std::string path, std::uint64_t run_hash) {
+    CheckpointHeader header;
+    std::memcpy(header.magic, checkpoint_magic, sizeof(header.magic));
+    header.run_hash = run_hash;
+    header.payload_size = data.size();
+    header.checksum = checksum(data.data(), data.size());
+
+    std::string tmp = path + ".tmp" + std::to_string(getpid());
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = ::write(fd, &header, sizeof(header)) == sizeof(header);
+    std::size_t done = 0;
+    while (ok && done < data.size()) {
+        ssize_t n = ::write(fd, data.data() + done, data.size() - done);
+        ok = n > 0;
+        done = done + (ok ? n : 0);
+    }
+    // the new file is on the disk before it replaces the old one
+    ok = ok && fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+/////////////// READER ////////////////
+
+bool CheckpointReader::open(std::string path, std::uint64_t run_hash) {
+    if (!open(path) || this->run_hash != run_hash) {
+        good = false;
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+bool CheckpointReader::open(std::string path) {
+    good = false;
+    pos = 0;
+    data.clear();
+
+    std::ifstream file(path, std::ios::binary);
+    CheckpointHeader header;
+    if (!file.read((char *)&header, sizeof(header)) ||
+        std::memcmp(header.magic, checkpoint_magic, 8) != 0) {
+        return false;
+    }
+    run_hash = header.run_hash;
+
+    // a damaged size could ask for more memory than there is
+    std::streamoff start = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff end = file.tellg();
+    if (start < 0 || end < start ||
+        header.payload_size > std::uint64_t(end - start)) {
+        return false;
+    }
+    file.seekg(start);
+    data.resize(header.payload_size);
+    if (!file.read(data.data(), data.size()) ||
+        checksum(data.data(), data.size()) != header.checksum) {
+        data.clear();
+        return false;
+    }
+    good = true;
+    return true;
+}
+
+void CheckpointReader::getBytes(void *bytes, std::size_t n) {
+    if (!good || n > data.size() - pos) {
+        good = false;
+        return;
+    }
+    std::memcpy(bytes, data.data() + pos, n);
+    pos = pos + n;
+}
+
+bool CheckpointReader::isGood() { return good; }
+std::uint64_t CheckpointReader::getRunHash() { return run_hash; }
+
+/////////////// OUTPUT FILES ////////////////
+
+long long streamSize(std::ofstream *file) {
+    if (!file->is_open()) {
+        return -1;
+    }
+    file->flush();
+    return (long long)file->tellp();
+}
+
+long long streamSize(OutputFile *file) {
+    file->flush();
+    return file->getSize();
+}
+
+bool resumeStream(std::ofstream *file, std::string path, long long size) {
+    if (file->is_open()) {
+        file->close();
+    }
+    if (truncate(path.c_str(), size) != 0) {
+        return false;
+    }
+    // not ios::app, whose tellp does not start at the end
+    file->open(path, std::ios::binary | std::ios::in | std::ios::out);
+    file->seekp(0, std::ios::end);
+    return file->is_open();
+}
+
+bool resumeStream(OutputFile *file, std::string path, long long size) {
+    file->close();
+    if (truncate(path.c_str(), size) != 0) {
+        return false;
+    }
+    return file->open(path, true);
+}
@@ -0,0 +1,103 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "OutputWriter.h"
+
+/* CHECKPOINTS
+ * THE STATE OF A RUN BETWEEN TWO SWEEPS, FROM WHICH A RUN THAT WAS STOPPED
+ * GOES ON EXACTLY AS IF IT HAD NEVER STOPPED. EVERY CLASS WITH STATE WRITES
+ * ITS OWN PART (saveState) AS RAW BYTES IN A FIXED ORDER AND READS IT BACK
+ * IN THE SAME ORDER (loadState): THE POSITIONS, THE GENERATORS, THE
+ * NEIGHBOUR STRUCTURES AS THEIR HISTORY LEFT THEM (THE PAIR SUMS FOLLOW
+ * THEIR ORDER), THE RUNNING ENERGIES, THE HISTOGRAMS AND AVERAGES, AND THE
+ * LENGTH OF EVERY OUTPUT FILE, WHICH IS CUT BACK TO IT ON A RESTART. THE
+ * FILE IS THE HEADER BELOW AND THE PARTS. IT IS WRITTEN UNDER ANOTHER NAME,
+ * FLUSHED TO THE DISK AND RENAMED OVER THE LAST ONE, SO A RUN KILLED WHILE
+ * WRITING IT LEAVES THE PREVIOUS CHECKPOINT WHOLE
+ */
+struct CheckpointHeader {
+    char magic[8];              // "MCCHKP1" and a zero
+    std::uint64_t run_hash;     // Parameters::getRunHash
+    std::uint64_t payload_size; // bytes after the header
+    std::uint64_t checksum;     // FNV-1a of those bytes
+};
+
+class CheckpointWriter {
+
+  private:
+    std::vector<char> data; // the parts, kept between checkpoints
+
+  public:
+    void clear();
+    void putBytes(const void *bytes, std::size_t n);
+
+    template <class T> void put(const T &value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only plain values are written as bytes");
+        putBytes(&value, sizeof(T));
+    }
+    template <class T> void putVector(const std::vector<T> &values) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only plain values are written as bytes");
+        put(std::uint64_t(values.size()));
+        putBytes(values.data(), values.size() * sizeof(T));
+    }
+
+    // writes path + ".tmp<pid>" and renames it over path, false on any
+    // error. runs that write the same path never write into one file
+    bool commit(std::string path, std::uint64_t run_hash);
+    std::size_t size();
+};
+
+class CheckpointReader {
+
+  private:
+    std::vector<char> data;
+    std::size_t pos = 0;
+    bool good = false;
+    std::uint64_t run_hash = 0;
+
+  public:
+    // false if the file is missing, cut short or of another run
+    bool open(std::string path, std::uint64_t run_hash);
+    // a whole file of whichever run wrote it (getRunHash)
+    bool open(std::string path);
+    std::uint64_t getRunHash();
+    void getBytes(void *bytes, std::size_t n);
+
+    template <class T> void get(T *value) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only plain values are read as bytes");
+        getBytes(value, sizeof(T));
+    }
+    template <class T> void getVector(std::vector<T> *values) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "only plain values are read as bytes");
+        std::uint64_t n = 0;
+        get(&n);
+        if (!good || n > (data.size() - pos) / sizeof(T)) {
+            good = false;
+            return;
+        }
+        values->resize(n);
+        getBytes(values->data(), n * sizeof(T));
+    }
+
+    // false once a read went past the end of the parts
+    bool isGood();
+};
+
+// the bytes written to file so far, flushed to it, -1 if it is not open
+long long streamSize(std::ofstream *file);
+long long streamSize(OutputFile *file);
+// cuts path back to size bytes and opens it to write on from there
+bool resumeStream(std::ofstream *file, std::string path, long long size);
+bool resumeStream(OutputFile *file, std::string path, long long size);
+#endif
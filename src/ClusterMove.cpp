@@ -0,0 +1,222 @@
+#include <cmath>
+
+#include "ClusterMove.h"
+
+// index displaced by dx,dy and put back in the box the way single moves are.
+// false if the displacement takes it through a rigid wall
+bool ClusterMove::displace(ParticleStore *particles, Boundary *bound,
+                           int index, double dx, double dy, double *x,
+                           double *y) {
+    particles->setX_TrialPos(index, particles->getX_Position(index) + dx);
+    particles->setY_TrialPos(index, particles->getY_Position(index) + dy);
+
+    bool inside = true;
+    if (bound_type == 1) {
+        bound->periodicBoundary(particles, index);
+    } else if (bound_type == 0) {
+        inside = bound->rigidBoundary(particles, index);
+    }
+    *x = particles->getX_TrialPos(index);
+    *y = particles->getY_TrialPos(index);
+    return inside;
+}
+
+// adds the pair energies of index placed at x,y into e, indexed by the other
+// particle of the pair
+void ClusterMove::addEnergies(ParticleStore *particles, Interaction *interact,
+                              int index, double x, double y, double *e) {
+    others.clear();
+    energies.clear();
+    interact->pairEnergies(particles, index, x, y, &others, &energies);
+
+    for (int n = 0; n < int(others.size()); n++) {
+        int k = others[n];
+        if (!touched[k]) {
+            touched[k] = 1;
+            neighbors.push_back(k);
+        }
+        e[k] = e[k] + energies[n];
+    }
+}
+
+// recruits the cluster from the seed in members[0]. false if the move has to
+// be rejected, because of a frustrated link or a rigid wall
+bool ClusterMove::grow(ParticleStore *particles, Interaction *interact,
+                       Boundary *bound, RNG *rand, double dx,
+                       double dy) {
+    double beta = 1 / red_temp;
+
+    for (int m = 0; m < int(members.size()); m++) {
+        int i = members[m];
+
+        double x_rev = 0;
+        double y_rev = 0;
+        if (!displace(particles, bound, i, dx, dy, &x_new[i], &y_new[i])) {
+            return false;
+        }
+        displace(particles, bound, i, -dx, -dy, &x_rev, &y_rev);
+
+        neighbors.clear();
+        addEnergies(particles, interact, i, particles->getX_Position(i),
+                    particles->getY_Position(i), e_init.data());
+        addEnergies(particles, interact, i, x_new[i], y_new[i],
+                    e_fwd.data());
+        addEnergies(particles, interact, i, x_rev, y_rev, e_rev.data());
+
+        bool frustrated = false;
+        for (int n = 0; n < int(neighbors.size()); n++) {
+            int k = neighbors[n];
+            double init = e_init[k];
+            double fwd = e_fwd[k];
+            double rev = e_rev[k];
+            e_init[k] = 0;
+            e_fwd[k] = 0;
+            e_rev[k] = 0;
+            touched[k] = 0;
+
+            if (in_cluster[k] || frustrated) {
+                continue;
+            }
+            double p_fwd = fmax(0.0, 1 - exp(beta * (init - fwd)));
+            if (rand->RandomUniformDbl() < p_fwd) {
+                double p_rev = fmax(0.0, 1 - exp(beta * (init - rev)));
+                if (rand->RandomUniformDbl() >= p_rev / p_fwd) {
+                    frustrated = true;
+                    continue;
+                }
+                in_cluster[k] = 1;
+                members.push_back(k);
+            } else {
+                // log of the chance the link also fails in the reverse move
+                // over its chance to fail here, which only matters if k
+                // ends up in the cluster after all
+                double fail = fmin(0.0, beta * (init - fwd));
+                double fail_rev = fmin(0.0, beta * (init - rev));
+                edge_i.push_back(i);
+                edge_j.push_back(k);
+                edge_delta.push_back(fwd - init);
+                edge_ratio.push_back(fail_rev - fail);
+            }
+        }
+        if (frustrated) {
+            ++n_frustrated;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ClusterMove::attempt(ParticleStore *particles, Interaction *interact,
+                          Boundary *bound, EnergyTracker *energy,
+                          RNG *rand) {
+    int n_particles = particles->size();
+    if (int(in_cluster.size()) != n_particles) {
+        in_cluster.assign(n_particles, 0);
+        x_new.assign(n_particles, 0);
+        y_new.assign(n_particles, 0);
+        e_init.assign(n_particles, 0);
+        e_fwd.assign(n_particles, 0);
+        e_rev.assign(n_particles, 0);
+        touched.assign(n_particles, 0);
+    }
+
+    int seed = int(rand->RandomUniformDbl() * n_particles);
+    double step = particles->getStepWeight(seed);
+    double dx = step * (rand->RandomUniformDbl() - 0.5);
+    double dy = step * (rand->RandomUniformDbl() - 0.5);
+
+    members.clear();
+    edge_i.clear();
+    edge_j.clear();
+    edge_delta.clear();
+    edge_ratio.clear();
+    members.push_back(seed);
+    in_cluster[seed] = 1;
+    ++n_attempts;
+
+    bool accept = grow(particles, interact, bound, rand, dx, dy);
+    sum_size = sum_size + members.size();
+
+    // the Boltzmann factors of the pairs across the edge of the cluster are
+    // taken care of by the links. what is left are the links that failed
+    // inside the cluster and the external well
+    if (accept) {
+        double log_acc = 0;
+        for (int e = 0; e < int(edge_i.size()); e++) {
+            if (in_cluster[edge_j[e]]) {
+                log_acc = log_acc + edge_ratio[e];
+            }
+        }
+        if (bound_type == 2) {
+            double delta_energy = 0;
+            for (int m = 0; m < int(members.size()); m++) {
+                int i = members[m];
+                particles->setX_TrialPos(i, x_new[i]);
+                particles->setY_TrialPos(i, y_new[i]);
+                delta_energy =
+                    delta_energy + bound->externalWell(particles, i);
+            }
+            log_acc = log_acc - delta_energy / red_temp;
+        }
+        if (log_acc < 0) {
+            accept = rand->RandomUniformDbl() < exp(log_acc);
+        }
+    }
+
+    if (accept) {
+        for (int e = 0; e < int(edge_i.size()); e++) {
+            if (!in_cluster[edge_j[e]]) {
+                energy->addPairChange(edge_i[e], edge_j[e], edge_delta[e]);
+            }
+        }
+        for (int m = 0; m < int(members.size()); m++) {
+            int i = members[m];
+            particles->setX_TrialPos(i, x_new[i]);
+            particles->setY_TrialPos(i, y_new[i]);
+            particles->acceptTrial(i);
+            interact->updateNeighborLists(particles, i);
+        }
+        ++n_accepts;
+    }
+
+    for (int m = 0; m < int(members.size()); m++) {
+        in_cluster[members[m]] = 0;
+    }
+    return accept;
+}
+
+bool ClusterMove::isActive() { return active; }
+double ClusterMove::getRatio() { return ratio; }
+long long ClusterMove::getNumAttempts() { return n_attempts; }
+long long ClusterMove::getNumAccepts() { return n_accepts; }
+long long ClusterMove::getNumFrustrated() { return n_frustrated; }
+double ClusterMove::getAvgSize() {
+    return n_attempts > 0 ? sum_size / n_attempts : 0;
+}
+
+void ClusterMove::saveState(CheckpointWriter *out) {
+    out->put(n_attempts);
+    out->put(n_accepts);
+    out->put(n_frustrated);
+    out->put(sum_size);
+}
+
+void ClusterMove::loadState(CheckpointReader *in) {
+    in->get(&n_attempts);
+    in->get(&n_accepts);
+    in->get(&n_frustrated);
+    in->get(&sum_size);
+}
+
+// the links need a pair energy, so hard disks keep the single moves
+void ClusterMove::initializeClusterMove(Parameters *p) {
+    ratio = p->getClusterRatio();
+    active = ratio > 0 && p->getInteract_Type() != 0;
+    red_temp = p->getRedTemp();
+    bound_type = p->getBound_Type();
+
+    n_attempts = 0;
+    n_accepts = 0;
+    n_frustrated = 0;
+    sum_size = 0;
+}
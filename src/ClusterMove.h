@@ -0,0 +1,87 @@
+#ifndef CLUSTERMOVE_H
+#define CLUSTERMOVE_H
+
+#include <vector>
+
+#include "Boundary.h"
+#include "Checkpoint.h"
+#include "EnergyTracker.h"
+#include "Interaction.h"
+#include "Parameters.h"
+#include "ParticleStore.h"
+#include "RNG.h"
+
+/* VIRTUAL-MOVE CLUSTER TRANSLATION
+ * A SEED PARTICLE IS GIVEN A RANDOM DISPLACEMENT AND ITS NEIGHBOURS ARE
+ * RECRUITED INTO THE CLUSTER ONE PAIR AT A TIME. A NEIGHBOUR j OF A MEMBER i
+ * IS LINKED WITH PROBABILITY p = max(0, 1 - exp(-beta (e_fwd - e_init)))
+ * WHERE e_fwd IS THE PAIR ENERGY WITH ONLY i DISPLACED. THE SAME TEST FOR
+ * THE REVERSE DISPLACEMENT, q, DECIDES WHETHER THE LINK WOULD BE FORMED IN
+ * THE REVERSE MOVE: THE LINK IS KEPT WITH PROBABILITY min(1, q / p) AND THE
+ * WHOLE MOVE IS REJECTED OTHERWISE. THE PAIRS LEFT UNLINKED ACROSS THE EDGE
+ * OF THE CLUSTER THEN CARRY THEIR OWN BOLTZMANN FACTOR. THE MOVE IS ACCEPTED
+ * WITH THE RATIO OF THE REVERSE TO THE FORWARD PROBABILITY OF THE LINKS THAT
+ * FAILED BETWEEN TWO PARTICLES THAT ENDED UP IN THE CLUSTER ANYWAY, TIMES THE
+ * BOLTZMANN FACTOR OF THE EXTERNAL WELL (WHITELAM AND GEISSLER'S VIRTUAL-MOVE
+ * MONTE CARLO). BUNDLES OF STRONGLY BOUND PARTICLES ARE MOVED AS A WHOLE
+ * INSTEAD OF BEING TORN APART
+ */
+class ClusterMove {
+
+  private:
+    bool active = false;
+    double ratio = 0; // fraction of the moves that are cluster moves
+    double red_temp = 0;
+    int bound_type = 0;
+
+    std::vector<char> in_cluster;
+    std::vector<int> members;
+    std::vector<double> x_new; // the displaced positions of the members
+    std::vector<double> y_new;
+
+    // pair energies of the neighbours of the member being grown from, with
+    // the member where it is, displaced and displaced back
+    std::vector<double> e_init;
+    std::vector<double> e_fwd;
+    std::vector<double> e_rev;
+    std::vector<char> touched;
+    std::vector<int> neighbors;
+    std::vector<int> others;
+    std::vector<double> energies;
+
+    // unlinked pairs between a member and an outside particle
+    std::vector<int> edge_i;
+    std::vector<int> edge_j;
+    std::vector<double> edge_delta;
+    std::vector<double> edge_ratio;
+
+    long long n_attempts = 0;
+    long long n_accepts = 0;
+    long long n_frustrated = 0;
+    double sum_size = 0;
+
+    bool displace(ParticleStore *particles, Boundary *bound, int index,
+                  double dx, double dy, double *x, double *y);
+    void addEnergies(ParticleStore *particles, Interaction *interact,
+                     int index, double x, double y, double *e);
+    bool grow(ParticleStore *particles, Interaction *interact,
+              Boundary *bound, RNG *rand, double dx, double dy);
+
+  public:
+    void initializeClusterMove(Parameters *p);
+
+    // one cluster move, returns true if it was accepted
+    bool attempt(ParticleStore *particles, Interaction *interact,
+                 Boundary *bound, EnergyTracker *energy, RNG *rand);
+
+    bool isActive();
+    double getRatio();
+    long long getNumAttempts();
+    long long getNumAccepts();
+    long long getNumFrustrated();
+    double getAvgSize();
+
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+};
+#endif
@@ -0,0 +1,124 @@
+#include <cmath>
+#include <cstdio>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "ConfigCache.h"
+
+void ConfigCache::initializeConfigCache(Parameters *p) {
+    dir = p->getConfigCache();
+    physics_hash = p->getPhysicsHash();
+    system_hash = p->getSystemHash();
+    interact_type = p->getInteract_Type();
+    red_dens = p->getRedDens();
+    red_temp = p->getRedTemp();
+    box_length = p->getBoxLength();
+
+    found.clear();
+    exact = false;
+    found_dens = 0;
+    found_temp = 0;
+}
+
+bool ConfigCache::isActive() { return !dir.empty(); }
+
+std::string ConfigCache::cachePath(unsigned long long hash) {
+    char name[24];
+    std::snprintf(name, sizeof(name), "%016llx.cfg", hash);
+    return dir + "/" + name;
+}
+
+bool ConfigCache::readHeader(CheckpointReader *in, double *dens,
+                             double *temp, double *box) {
+    unsigned long long system = 0;
+    in->get(&system);
+    in->get(dens);
+    in->get(temp);
+    in->get(box);
+    return in->isGood() && system == system_hash;
+}
+
+bool ConfigCache::load(ParticleStore *particles) {
+    found.clear();
+    exact = false;
+
+    DIR *listing = isActive() ? opendir(dir.c_str()) : nullptr;
+    if (listing == nullptr) {
+        return false;
+    }
+
+    // the distance of two state points, relative to this one. the same
+    // state point is closest of all
+    std::string best;
+    double best_distance = HUGE_VAL;
+    CheckpointReader in;
+    for (dirent *entry = readdir(listing); entry != nullptr;
+         entry = readdir(listing)) {
+        std::string name = entry->d_name;
+        if (name.size() < 4 || name.compare(name.size() - 4, 4, ".cfg")) {
+            continue;
+        }
+        std::string path = dir + "/" + name;
+        double dens = 0;
+        double temp = 0;
+        double box = 0;
+        if (!in.open(path) || !readHeader(&in, &dens, &temp, &box)) {
+            continue;
+        }
+        if (interact_type == 0 && box > box_length) {
+            continue;
+        }
+        double distance = pow((dens - red_dens) / red_dens, 2) +
+                          pow((temp - red_temp) / red_temp, 2);
+        if (in.getRunHash() == physics_hash) {
+            distance = -1;
+        }
+        // ties go by name, so the choice does not depend on the listing
+        if (distance < best_distance ||
+            (distance == best_distance && path < best)) {
+            best = path;
+            best_distance = distance;
+        }
+    }
+    closedir(listing);
+
+    double box = 0;
+    if (best.empty() || !in.open(best) ||
+        !readHeader(&in, &found_dens, &found_temp, &box)) {
+        return false;
+    }
+    particles->loadState(&in);
+    if (!in.isGood()) {
+        return false;
+    }
+
+    // the configuration keeps its shape in the new box
+    double scale = box_length / box;
+    for (int k = 0; k < particles->size(); k++) {
+        particles->setX_Position(k, particles->getX_Position(k) * scale);
+        particles->setY_Position(k, particles->getY_Position(k) * scale);
+    }
+    found = best;
+    exact = best_distance < 0;
+    return true;
+}
+
+bool ConfigCache::save(ParticleStore *particles) {
+    if (!isActive()) {
+        return false;
+    }
+    mkdir(dir.c_str(), 0755); // an existing directory is fine
+
+    CheckpointWriter out;
+    out.put(system_hash);
+    out.put(red_dens);
+    out.put(red_temp);
+    out.put(box_length);
+    particles->saveState(&out);
+    return out.commit(cachePath(physics_hash), physics_hash);
+}
+
+std::string ConfigCache::getFound() { return found; }
+bool ConfigCache::isExact() { return exact; }
+double ConfigCache::getFoundDens() { return found_dens; }
+double ConfigCache::getFoundTemp() { return found_temp; }
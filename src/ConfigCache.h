@@ -0,0 +1,57 @@
+#ifndef CONFIGCACHE_H
+#define CONFIGCACHE_H
+
+#include <string>
+
+#include "Checkpoint.h"
+#include "Parameters.h"
+#include "ParticleStore.h"
+
+/* CACHE OF EQUILIBRATED CONFIGURATIONS
+ * A SINGLE RUN WITH config_cache LEAVES ITS CONFIGURATION AT THE END OF ITS
+ * EQUILIBRATION IN THAT DIRECTORY, IN A FILE NAMED AFTER THE PHYSICS HASH OF
+ * ITS PARAMETERS. A LATER RUN OF THE SAME SYSTEM (THE SAME PARTICLES,
+ * INTERACTIONS AND BOUNDARY, Parameters::getSystemHash) STARTS FROM THE
+ * CACHED CONFIGURATION OF THE CLOSEST STATE POINT INSTEAD OF A LATTICE,
+ * SCALED TO ITS OWN BOX, AND ONLY RE-EQUILIBRATES FOR A FEW SWEEPS. HARD
+ * DISKS ARE NEVER COMPRESSED, WHICH WOULD MAKE THEM OVERLAP. THE FILES ARE
+ * CHECKPOINT FILES (Checkpoint.h), SO A HALF WRITTEN ONE IS NEVER READ
+ */
+class ConfigCache {
+
+  private:
+    std::string dir; // "" if there is no cache
+    unsigned long long physics_hash = 0;
+    unsigned long long system_hash = 0;
+    int interact_type = 0;
+    double red_dens = 0;
+    double red_temp = 0;
+    double box_length = 0;
+
+    // the configuration load started from
+    std::string found;
+    bool exact = false;
+    double found_dens = 0;
+    double found_temp = 0;
+
+    // the state point, which the particles follow in the file
+    bool readHeader(CheckpointReader *in, double *dens, double *temp,
+                    double *box);
+
+  public:
+    void initializeConfigCache(Parameters *p);
+    bool isActive();
+    std::string cachePath(unsigned long long hash);
+
+    // the types and positions of the closest cached configuration of the
+    // system, false (and the particles untouched) if there is none
+    bool load(ParticleStore *particles);
+    // false if the directory or the file could not be written
+    bool save(ParticleStore *particles);
+
+    std::string getFound();
+    bool isExact();
+    double getFoundDens();
+    double getFoundTemp();
+};
+#endif
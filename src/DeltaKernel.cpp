@@ -0,0 +1,89 @@
+#include "DeltaKernel.h"
+
+namespace {
+
+template <class Pair>
+double scalarKernel(const KernelParams &p, const double *x, const double *y,
+                    const int *type, int n, const KernelMove &m) {
+    return scalarDelta<Pair>(p, x, y, type, 0, n, m);
+}
+
+} // namespace
+
+DeltaKernelFn deltaKernelScalar(int interact_type) {
+    switch (interact_type) {
+    case 1:
+        return scalarKernel<LennardJonesPair>;
+    case 2:
+        return scalarKernel<WCAPair>;
+    case 3:
+        return scalarKernel<WCASpringPair>;
+    }
+    return nullptr;
+}
+
+int bestKernelLevel() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (deltaKernelAVX512(1) != nullptr && __builtin_cpu_supports("avx512f")) {
+        return KERNEL_AVX512;
+    }
+    if (deltaKernelAVX2(1) != nullptr && __builtin_cpu_supports("avx2") &&
+        __builtin_cpu_supports("fma")) {
+        return KERNEL_AVX2;
+    }
+#endif
+    return KERNEL_SCALAR;
+}
+
+const char *kernelLevelName(int level) {
+    switch (level) {
+    case KERNEL_AVX2:
+        return "avx2";
+    case KERNEL_AVX512:
+        return "avx512";
+    }
+    return "scalar";
+}
+
+DeltaKernelFn deltaKernel(int level, int interact_type) {
+    switch (level) {
+    case KERNEL_AVX2:
+        return deltaKernelAVX2(interact_type);
+    case KERNEL_AVX512:
+        return deltaKernelAVX512(interact_type);
+    }
+    return deltaKernelScalar(interact_type);
+}
+
+bool DeltaKernel::isActive() { return active; }
+int DeltaKernel::getLevel() { return level; }
+
+double DeltaKernel::delta(const double *x, const double *y, const int *type,
+                          int n, const KernelMove &m) {
+    return kernel(params, x, y, type, n, m);
+}
+
+double DeltaKernel::wrappedDelta(const double *x, const double *y,
+                                 const int *type, int n,
+                                 const KernelMove &m) {
+    return kernel(wrap_params, x, y, type, n, m);
+}
+
+void DeltaKernel::initializeDeltaKernel(Parameters *p, Potential *pot,
+                                        int requested_level) {
+    params.pair.initializePairParams(p, pot, nullptr);
+    params.inv_sigma2 = 1 / (p->getSigma() * p->getSigma());
+    params.trunc_dist2 = pot->getTruncDist() * pot->getTruncDist();
+
+    wrap_params = params;
+    wrap_params.box_L = p->getBoxLength();
+    wrap_params.inv_box_L = 1 / p->getBoxLength();
+
+    level = requested_level;
+    if (level > bestKernelLevel()) {
+        level = bestKernelLevel();
+    }
+    kernel = deltaKernel(level, pot->getInteract_Type());
+    active = (kernel != nullptr);
+}
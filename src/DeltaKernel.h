@@ -0,0 +1,110 @@
+#ifndef DELTAKERNEL_H
+#define DELTAKERNEL_H
+
+#include <cmath>
+
+#include "PairPotentials.h"
+#include "Parameters.h"
+#include "Potential.h"
+
+/* VECTORIZED DELTA-ENERGY KERNEL
+ * THE CHANGE IN ENERGY OF A SINGLE-PARTICLE MOVE IS THE SUM OF THE PAIR
+ * ENERGIES AT THE TRIAL POSITION MINUS THE SUM AT THE CURRENT POSITION, BOTH
+ * OVER THE SAME BLOCK OF NEIGHBOURS. THE KERNEL TAKES THAT BLOCK AS
+ * CONTIGUOUS x, y AND type ARRAYS AND EVALUATES BOTH SUMS IN ONE PASS. THERE
+ * IS AN AVX-512 AND AN AVX2 VERSION (EACH IN ITS OWN TRANSLATION UNIT, BUILT
+ * FOR THAT INSTRUCTION SET) AND A SCALAR FALLBACK; THE WIDEST ONE THE CPU
+ * SUPPORTS IS PICKED ONCE AT STARTUP. THE SPRING TERM NEEDS exp, WHICH THE
+ * VECTOR VERSIONS EVALUATE WITH THEIR OWN POLYNOMIAL
+ */
+enum KernelLevel { KERNEL_SCALAR = 0, KERNEL_AVX2 = 1, KERNEL_AVX512 = 2 };
+
+struct KernelParams {
+    PairParams pair;
+    double inv_sigma2 = 0;
+    double trunc_dist2 = 0;
+    double box_L = 0; // 0 = the block already holds the nearest images
+    double inv_box_L = 0;
+};
+
+// the particle that is moved
+struct KernelMove {
+    int type = 0;
+    double x_temp = 0;
+    double y_temp = 0;
+    double x_curr = 0;
+    double y_curr = 0;
+};
+
+typedef double (*DeltaKernelFn)(const KernelParams &p, const double *x,
+                                const double *y, const int *type, int n,
+                                const KernelMove &m);
+
+// the kernels of each instruction set, nullptr if they were not compiled in
+DeltaKernelFn deltaKernelScalar(int interact_type);
+DeltaKernelFn deltaKernelAVX2(int interact_type);
+DeltaKernelFn deltaKernelAVX512(int interact_type);
+
+// widest level supported by both the build and the CPU
+int bestKernelLevel();
+const char *kernelLevelName(int level);
+DeltaKernelFn deltaKernel(int level, int interact_type);
+
+// the scalar sum over particles [first, n) of the block. it is the fallback
+// and also finishes the remainder of the vector loops
+template <class Pair>
+inline double scalarDelta(const KernelParams &p, const double *x,
+                          const double *y, const int *type, int first, int n,
+                          const KernelMove &m) {
+    double delta_energy = 0;
+
+    for (int k = first; k < n; k++) {
+        int kind = (m.type != type[k]);
+
+        double dx_temp = x[k] - m.x_temp;
+        double dy_temp = y[k] - m.y_temp;
+        double dx_curr = x[k] - m.x_curr;
+        double dy_curr = y[k] - m.y_curr;
+        if (p.box_L > 0) {
+            dx_temp = dx_temp - p.box_L * floor(dx_temp * p.inv_box_L + 0.5);
+            dy_temp = dy_temp - p.box_L * floor(dy_temp * p.inv_box_L + 0.5);
+            dx_curr = dx_curr - p.box_L * floor(dx_curr * p.inv_box_L + 0.5);
+            dy_curr = dy_curr - p.box_L * floor(dy_curr * p.inv_box_L + 0.5);
+        }
+        double r2_temp = (dx_temp * dx_temp + dy_temp * dy_temp) * p.inv_sigma2;
+        double r2_curr = (dx_curr * dx_curr + dy_curr * dy_curr) * p.inv_sigma2;
+
+        if (r2_temp < p.trunc_dist2) {
+            delta_energy = delta_energy + Pair::energy(p.pair, r2_temp, kind);
+        }
+        if (r2_curr < p.trunc_dist2) {
+            delta_energy = delta_energy - Pair::energy(p.pair, r2_curr, kind);
+        }
+    }
+    return delta_energy;
+}
+
+class DeltaKernel {
+
+  private:
+    int level = KERNEL_SCALAR;
+    bool active = false;
+
+    KernelParams params;      // for blocks of nearest images
+    KernelParams wrap_params; // for raw positions in a periodic box
+    DeltaKernelFn kernel = nullptr;
+
+  public:
+    // the requested level is lowered to what the CPU supports
+    void initializeDeltaKernel(Parameters *p, Potential *pot,
+                               int requested_level);
+
+    bool isActive();
+    int getLevel();
+
+    double delta(const double *x, const double *y, const int *type, int n,
+                 const KernelMove &m);
+    double wrappedDelta(const double *x, const double *y, const int *type,
+                        int n, const KernelMove &m);
+};
+#endif
@@ -0,0 +1,164 @@
+#include "DeltaKernel.h"
+
+// this file is built with -mavx2 -mfma (see CMakeLists.txt). without them the
+// kernels are left out and the dispatch falls back on the scalar loop
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+
+namespace {
+
+// exp(x) for -708 < x <= 0, as in the AVX-512 version. AVX2 has no scalef,
+// so 2^n is put together in the exponent bits
+inline __m256d exp256(__m256d x) {
+    x = _mm256_max_pd(x, _mm256_set1_pd(-700.0));
+    __m256d n = _mm256_round_pd(
+        _mm256_mul_pd(x, _mm256_set1_pd(1.4426950408889634)),
+        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r =
+        _mm256_fnmadd_pd(n, _mm256_set1_pd(6.93147180369123816490e-1), x);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(1.90821492927058770002e-10), r);
+
+    __m256d poly = _mm256_set1_pd(1.0 / 479001600.0);
+    const double coef[12] = {1.0 / 39916800.0, 1.0 / 3628800.0,
+                             1.0 / 362880.0,   1.0 / 40320.0,
+                             1.0 / 5040.0,     1.0 / 720.0,
+                             1.0 / 120.0,      1.0 / 24.0,
+                             1.0 / 6.0,        0.5,
+                             1.0,              1.0};
+    for (int c = 0; c < 12; c++) {
+        poly = _mm256_fmadd_pd(poly, r, _mm256_set1_pd(coef[c]));
+    }
+
+    __m256i e = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n));
+    e = _mm256_slli_epi64(_mm256_add_epi64(e, _mm256_set1_epi64x(1023)), 52);
+    return _mm256_mul_pd(poly, _mm256_castsi256_pd(e));
+}
+
+// squared characteristic distance from x0,y0 to the block
+inline __m256d dist2(const KernelParams &p, __m256d x, __m256d y, double x0,
+                     double y0) {
+    __m256d dx = _mm256_sub_pd(x, _mm256_set1_pd(x0));
+    __m256d dy = _mm256_sub_pd(y, _mm256_set1_pd(y0));
+    if (p.box_L > 0) {
+        __m256d L = _mm256_set1_pd(p.box_L);
+        __m256d inv_L = _mm256_set1_pd(p.inv_box_L);
+        __m256d half = _mm256_set1_pd(0.5);
+        dx = _mm256_fnmadd_pd(
+            L, _mm256_floor_pd(_mm256_fmadd_pd(dx, inv_L, half)), dx);
+        dy = _mm256_fnmadd_pd(
+            L, _mm256_floor_pd(_mm256_fmadd_pd(dy, inv_L, half)), dy);
+    }
+    return _mm256_mul_pd(_mm256_fmadd_pd(dx, dx, _mm256_mul_pd(dy, dy)),
+                         _mm256_set1_pd(p.inv_sigma2));
+}
+
+// pair energies of the block, zero past the truncation distance. a holds the
+// affinity of each pair
+template <int TYPE>
+inline __m256d energy256(const KernelParams &p, __m256d r2, __m256d a) {
+    __m256d ir6 = _mm256_div_pd(_mm256_set1_pd(1.0),
+                                _mm256_mul_pd(_mm256_mul_pd(r2, r2), r2));
+    __m256d lj = _mm256_sub_pd(_mm256_mul_pd(ir6, ir6), ir6);
+    __m256d e;
+
+    if (TYPE == 1) {
+        e = _mm256_mul_pd(
+            _mm256_mul_pd(_mm256_set1_pd(4.0), a),
+            _mm256_add_pd(lj, _mm256_set1_pd(p.pair.trunc_shift)));
+    } else {
+        __m256d in_wca =
+            _mm256_cmp_pd(r2, _mm256_set1_pd(p.pair.wca_cut2), _CMP_LE_OQ);
+        __m256d wca = _mm256_mul_pd(_mm256_set1_pd(4.0),
+                                    _mm256_add_pd(lj, _mm256_set1_pd(.25)));
+        e = _mm256_and_pd(in_wca, wca);
+    }
+    if (TYPE == 3) {
+        __m256d u = _mm256_sub_pd(_mm256_sqrt_pd(r2),
+                                  _mm256_set1_pd(p.pair.rest_L));
+        __m256d ku2 = _mm256_mul_pd(_mm256_set1_pd(p.pair.k_spring),
+                                    _mm256_mul_pd(u, u));
+        __m256d spring = _mm256_mul_pd(
+            _mm256_mul_pd(a, _mm256_set1_pd(.5 * p.pair.red_temp)),
+            _mm256_mul_pd(ku2,
+                          exp256(_mm256_mul_pd(_mm256_set1_pd(-.5), ku2))));
+        e = _mm256_add_pd(e, spring);
+    }
+    __m256d in_cut =
+        _mm256_cmp_pd(r2, _mm256_set1_pd(p.trunc_dist2), _CMP_LT_OQ);
+    return _mm256_and_pd(in_cut, e);
+}
+
+// change in energy of the particles in x,y,type[0..4) whose lane is in use
+template <int TYPE>
+inline __m256d block256(const KernelParams &p, const double *x,
+                        const double *y, const int *type, __m256d use,
+                        const KernelMove &m) {
+    __m256d xv = _mm256_loadu_pd(x);
+    __m256d yv = _mm256_loadu_pd(y);
+    __m256d tv = _mm256_cvtepi32_pd(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(type)));
+    __m256d a = _mm256_blendv_pd(
+        _mm256_set1_pd(p.pair.affinity[0]), _mm256_set1_pd(p.pair.affinity[1]),
+        _mm256_cmp_pd(tv, _mm256_set1_pd(m.type), _CMP_NEQ_OQ));
+
+    __m256d e_temp =
+        energy256<TYPE>(p, dist2(p, xv, yv, m.x_temp, m.y_temp), a);
+    __m256d e_curr =
+        energy256<TYPE>(p, dist2(p, xv, yv, m.x_curr, m.y_curr), a);
+    return _mm256_and_pd(use, _mm256_sub_pd(e_temp, e_curr));
+}
+
+// nothing from the shared headers is instantiated here, so no code built for
+// AVX2 can be picked up by the linker for the other translation units
+template <int TYPE>
+double kernel256(const KernelParams &p, const double *x, const double *y,
+                 const int *type, int n, const KernelMove &m) {
+    __m256d sum = _mm256_setzero_pd();
+    __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+    int k = 0;
+    for (; k + 4 <= n; k += 4) {
+        sum = _mm256_add_pd(
+            sum, block256<TYPE>(p, x + k, y + k, type + k, all, m));
+    }
+
+    // the remainder is padded to a full vector and its unused lanes dropped
+    if (k < n) {
+        double x_pad[4];
+        double y_pad[4];
+        int type_pad[4];
+        long long lanes[4];
+        for (int j = 0; j < 4; j++) {
+            bool in = (k + j < n);
+            x_pad[j] = in ? x[k + j] : m.x_curr + 1;
+            y_pad[j] = in ? y[k + j] : m.y_curr;
+            type_pad[j] = in ? type[k + j] : m.type;
+            lanes[j] = in ? -1 : 0;
+        }
+        __m256d use = _mm256_castsi256_pd(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes)));
+        sum = _mm256_add_pd(
+            sum, block256<TYPE>(p, x_pad, y_pad, type_pad, use, m));
+    }
+
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum),
+                              _mm256_extractf128_pd(sum, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+}
+
+} // namespace
+
+DeltaKernelFn deltaKernelAVX2(int interact_type) {
+    switch (interact_type) {
+    case 1:
+        return kernel256<1>;
+    case 2:
+        return kernel256<2>;
+    case 3:
+        return kernel256<3>;
+    }
+    return nullptr;
+}
+#else
+DeltaKernelFn deltaKernelAVX2(int interact_type) { return nullptr; }
+#endif
@@ -0,0 +1,160 @@
+#include "DeltaKernel.h"
+
+// this file is built with -mavx512f (see CMakeLists.txt). without it the
+// kernels are left out and the dispatch falls back on a narrower level
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace {
+
+// exp(x) for -708 < x <= 0: x = n ln2 + r with |r| <= ln2 / 2, a degree 12
+// Taylor polynomial in r and a scale by 2^n (relative error ~1e-15)
+inline __m512d exp512(__m512d x) {
+    x = _mm512_max_pd(x, _mm512_set1_pd(-700.0));
+    __m512d n = _mm512_roundscale_pd(
+        _mm512_mul_pd(x, _mm512_set1_pd(1.4426950408889634)),
+        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r =
+        _mm512_fnmadd_pd(n, _mm512_set1_pd(6.93147180369123816490e-1), x);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(1.90821492927058770002e-10), r);
+
+    __m512d poly = _mm512_set1_pd(1.0 / 479001600.0);
+    const double coef[12] = {1.0 / 39916800.0, 1.0 / 3628800.0,
+                             1.0 / 362880.0,   1.0 / 40320.0,
+                             1.0 / 5040.0,     1.0 / 720.0,
+                             1.0 / 120.0,      1.0 / 24.0,
+                             1.0 / 6.0,        0.5,
+                             1.0,              1.0};
+    for (int c = 0; c < 12; c++) {
+        poly = _mm512_fmadd_pd(poly, r, _mm512_set1_pd(coef[c]));
+    }
+    return _mm512_scalef_pd(poly, n);
+}
+
+// squared characteristic distance from x0,y0 to the block
+inline __m512d dist2(const KernelParams &p, __m512d x, __m512d y, double x0,
+                     double y0) {
+    __m512d dx = _mm512_sub_pd(x, _mm512_set1_pd(x0));
+    __m512d dy = _mm512_sub_pd(y, _mm512_set1_pd(y0));
+    if (p.box_L > 0) {
+        __m512d L = _mm512_set1_pd(p.box_L);
+        __m512d inv_L = _mm512_set1_pd(p.inv_box_L);
+        __m512d half = _mm512_set1_pd(0.5);
+        dx = _mm512_fnmadd_pd(
+            L,
+            _mm512_roundscale_pd(_mm512_fmadd_pd(dx, inv_L, half),
+                                 _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC),
+            dx);
+        dy = _mm512_fnmadd_pd(
+            L,
+            _mm512_roundscale_pd(_mm512_fmadd_pd(dy, inv_L, half),
+                                 _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC),
+            dy);
+    }
+    return _mm512_mul_pd(_mm512_fmadd_pd(dx, dx, _mm512_mul_pd(dy, dy)),
+                         _mm512_set1_pd(p.inv_sigma2));
+}
+
+// pair energies of the block, zero past the truncation distance. a holds the
+// affinity of each pair
+template <int TYPE>
+inline __m512d energy512(const KernelParams &p, __m512d r2, __m512d a) {
+    __m512d ir6 = _mm512_div_pd(
+        _mm512_set1_pd(1.0), _mm512_mul_pd(_mm512_mul_pd(r2, r2), r2));
+    __m512d lj = _mm512_sub_pd(_mm512_mul_pd(ir6, ir6), ir6);
+    __m512d e;
+
+    if (TYPE == 1) {
+        e = _mm512_mul_pd(
+            _mm512_mul_pd(_mm512_set1_pd(4.0), a),
+            _mm512_add_pd(lj, _mm512_set1_pd(p.pair.trunc_shift)));
+    } else {
+        __mmask8 in_wca = _mm512_cmp_pd_mask(
+            r2, _mm512_set1_pd(p.pair.wca_cut2), _CMP_LE_OQ);
+        e = _mm512_maskz_mul_pd(in_wca, _mm512_set1_pd(4.0),
+                                _mm512_add_pd(lj, _mm512_set1_pd(.25)));
+    }
+    if (TYPE == 3) {
+        __m512d u = _mm512_sub_pd(_mm512_sqrt_pd(r2),
+                                  _mm512_set1_pd(p.pair.rest_L));
+        __m512d ku2 = _mm512_mul_pd(_mm512_set1_pd(p.pair.k_spring),
+                                    _mm512_mul_pd(u, u));
+        __m512d spring = _mm512_mul_pd(
+            _mm512_mul_pd(a, _mm512_set1_pd(.5 * p.pair.red_temp)),
+            _mm512_mul_pd(ku2,
+                          exp512(_mm512_mul_pd(_mm512_set1_pd(-.5), ku2))));
+        e = _mm512_add_pd(e, spring);
+    }
+    __mmask8 in_cut =
+        _mm512_cmp_pd_mask(r2, _mm512_set1_pd(p.trunc_dist2), _CMP_LT_OQ);
+    return _mm512_maskz_mov_pd(in_cut, e);
+}
+
+// change in energy of the particles in x,y,type[0..8) whose lane is in use
+template <int TYPE>
+inline __m512d block512(const KernelParams &p, const double *x,
+                        const double *y, const int *type, __mmask8 use,
+                        const KernelMove &m) {
+    __m512d xv = _mm512_loadu_pd(x);
+    __m512d yv = _mm512_loadu_pd(y);
+    __m512d tv = _mm512_cvtepi32_pd(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(type)));
+    __m512d a = _mm512_mask_blend_pd(
+        _mm512_cmp_pd_mask(tv, _mm512_set1_pd(m.type), _CMP_NEQ_OQ),
+        _mm512_set1_pd(p.pair.affinity[0]),
+        _mm512_set1_pd(p.pair.affinity[1]));
+
+    __m512d e_temp =
+        energy512<TYPE>(p, dist2(p, xv, yv, m.x_temp, m.y_temp), a);
+    __m512d e_curr =
+        energy512<TYPE>(p, dist2(p, xv, yv, m.x_curr, m.y_curr), a);
+    return _mm512_maskz_sub_pd(use, e_temp, e_curr);
+}
+
+// nothing from the shared headers is instantiated here, so no code built for
+// AVX-512 can be picked up by the linker for the other translation units
+template <int TYPE>
+double kernel512(const KernelParams &p, const double *x, const double *y,
+                 const int *type, int n, const KernelMove &m) {
+    __m512d sum = _mm512_setzero_pd();
+
+    int k = 0;
+    for (; k + 8 <= n; k += 8) {
+        sum = _mm512_add_pd(
+            sum, block512<TYPE>(p, x + k, y + k, type + k, 0xFF, m));
+    }
+
+    // the remainder is padded to a full vector and its unused lanes dropped
+    if (k < n) {
+        double x_pad[8];
+        double y_pad[8];
+        int type_pad[8];
+        for (int j = 0; j < 8; j++) {
+            bool in = (k + j < n);
+            x_pad[j] = in ? x[k + j] : m.x_curr + 1;
+            y_pad[j] = in ? y[k + j] : m.y_curr;
+            type_pad[j] = in ? type[k + j] : m.type;
+        }
+        __mmask8 use = __mmask8((1u << (n - k)) - 1);
+        sum = _mm512_add_pd(
+            sum, block512<TYPE>(p, x_pad, y_pad, type_pad, use, m));
+    }
+    return _mm512_reduce_add_pd(sum);
+}
+
+} // namespace
+
+DeltaKernelFn deltaKernelAVX512(int interact_type) {
+    switch (interact_type) {
+    case 1:
+        return kernel512<1>;
+    case 2:
+        return kernel512<2>;
+    case 3:
+        return kernel512<3>;
+    }
+    return nullptr;
+}
+#else
+DeltaKernelFn deltaKernelAVX512(int interact_type) { return nullptr; }
+#endif
@@ -0,0 +1,94 @@
+#include <cmath>
+
+#include "EnergyTracker.h"
+
+void EnergyTracker::reset(Interaction *interact, ParticleStore *particles) {
+    if (!active) {
+        return;
+    }
+    double *energies = per_particle ? particle_energy.data() : nullptr;
+    total = interact->totalEnergy(particles, energies);
+}
+
+void EnergyTracker::acceptMove(Interaction *interact,
+                               ParticleStore *particles, int index,
+                               double delta) {
+    addToTotal(delta);
+    spreadMove(interact, particles, index);
+}
+
+void EnergyTracker::spreadMove(Interaction *interact,
+                               ParticleStore *particles, int index) {
+    if (active && per_particle) {
+        interact->spreadDelta(particles, index, particle_energy.data());
+    }
+}
+
+void EnergyTracker::addToTotal(double delta) {
+    if (active) {
+        total = total + delta;
+    }
+}
+
+void EnergyTracker::addPairChange(int i, int j, double delta) {
+    if (!active) {
+        return;
+    }
+    total = total + delta;
+    if (per_particle) {
+        particle_energy[i] = particle_energy[i] + 0.5 * delta;
+        particle_energy[j] = particle_energy[j] + 0.5 * delta;
+    }
+}
+
+void EnergyTracker::endSweep(int sweep, Interaction *interact,
+                             ParticleStore *particles) {
+    if (!active || check_interval <= 0 || (sweep + 1) % check_interval != 0) {
+        return;
+    }
+    double running = total;
+    reset(interact, particles);
+
+    max_drift = fmax(max_drift, fabs(running - total));
+    ++n_checks;
+}
+
+bool EnergyTracker::isActive() { return active; }
+bool EnergyTracker::isPerParticle() { return active && per_particle; }
+double EnergyTracker::getTotal() { return total; }
+double EnergyTracker::getParticleEnergy(int index) {
+    return particle_energy[index];
+}
+const double *EnergyTracker::getParticleEnergies() {
+    return particle_energy.data();
+}
+int EnergyTracker::getNumChecks() { return n_checks; }
+double EnergyTracker::getMaxDrift() { return max_drift; }
+
+void EnergyTracker::saveState(CheckpointWriter *out) {
+    out->put(total);
+    out->putVector(particle_energy);
+    out->put(n_checks);
+    out->put(max_drift);
+}
+
+void EnergyTracker::loadState(CheckpointReader *in) {
+    in->get(&total);
+    in->getVector(&particle_energy);
+    in->get(&n_checks);
+    in->get(&max_drift);
+}
+
+// hard disks have no energy to keep track of
+void EnergyTracker::initializeEnergyTracker(Parameters *p) {
+    active = p->getTrackEnergy() && p->getInteract_Type() != 0;
+    per_particle = p->getPerParticleEnergy();
+    check_interval = p->getEnergyCheck();
+
+    total = 0;
+    n_checks = 0;
+    max_drift = 0;
+    if (active && per_particle) {
+        particle_energy.assign(p->getNumParticles(), 0);
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef ENERGYTRACKER_H
+#define ENERGYTRACKER_H
+
+#include <vector>
+
+#include "Checkpoint.h"
+#include "Interaction.h"
+#include "Parameters.h"
+#include "ParticleStore.h"
+
+/* RUNNING TOTAL ENERGY
+ * THE MONTE CARLO LOOP ALREADY KNOWS THE EXACT CHANGE IN PAIR ENERGY OF EVERY
+ * ACCEPTED MOVE, SO THE TOTAL PAIR ENERGY OF THE CONFIGURATION IS KEPT UP TO
+ * DATE FROM THOSE CHANGES INSTEAD OF BEING RECOMPUTED. OPTIONALLY THE ENERGY
+ * OF EVERY PARTICLE (HALF OF EACH OF ITS PAIRS) IS KEPT AS WELL. EVERY
+ * check_interval SWEEPS THE ENERGY IS RECOMPUTED FROM SCRATCH AND THE DRIFT
+ * OF THE RUNNING TOTAL IS RECORDED
+ */
+class EnergyTracker {
+
+  private:
+    bool active = false;
+    bool per_particle = false;
+    int check_interval = 0; // 0 = never recompute
+
+    double total = 0;
+    std::vector<double> particle_energy;
+
+    int n_checks = 0;
+    double max_drift = 0;
+
+  public:
+    void initializeEnergyTracker(Parameters *p);
+
+    // recomputes the energies from scratch
+    void reset(Interaction *interact, ParticleStore *particles);
+
+    // called for an accepted move before the trial position is taken over.
+    // delta is the change in pair energy only
+    void acceptMove(Interaction *interact, ParticleStore *particles, int index,
+                    double delta);
+
+    // acceptMove in two parts, for moves made on several threads at once:
+    // the energies of the particles around index, which are not shared
+    // between the threads, and the total, which is added up afterwards
+    void spreadMove(Interaction *interact, ParticleStore *particles,
+                    int index);
+    void addToTotal(double delta);
+
+    // change in energy of the pair i,j, for moves of several particles
+    void addPairChange(int i, int j, double delta);
+
+    // recomputes the energy and records the drift every check_interval sweeps
+    void endSweep(int sweep, Interaction *interact, ParticleStore *particles);
+
+    bool isActive();
+    bool isPerParticle();
+    double getTotal();
+    double getParticleEnergy(int index);
+    const double *getParticleEnergies();
+    int getNumChecks();
+    double getMaxDrift();
+
+    // the running totals, which differ from a fresh sum in the last bits
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+};
+#endif
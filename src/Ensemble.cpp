@@ -0,0 +1,101 @@
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+#include "Ensemble.h"
+
+void Ensemble::initializeEnsemble(std::string yamlFile, Parameters *p) {
+    param = *p;
+    n_updates = p->getUpdates();
+    int n_chains = p->getEnsembleChains();
+
+    n_threads = p->getNumThreads();
+    if (n_threads <= 0) {
+        n_threads = std::thread::hardware_concurrency();
+    }
+    if (n_threads <= 0) {
+        n_threads = 1; // the number of cores is not known
+    }
+    if (n_threads > n_chains) {
+        n_threads = n_chains;
+    }
+
+    chains.clear();
+    for (int c = 0; c < n_chains; c++) {
+        Parameters cp = *p;
+        cp.setStream(c + 1);
+        cp.setOutputPrefix(p->getOutputPrefix() + "chain" +
+                           std::to_string(c) + "_");
+
+        chains.emplace_back(new Simulation(yamlFile, cp));
+        chains.back()->setQuiet(true);
+    }
+}
+
+void Ensemble::runChain(int c) {
+    Simulation *sim = chains[c].get();
+    {
+        std::lock_guard<std::mutex> guard(out_lock);
+        sim->initializeRun();
+    }
+    // a warm start skips most of the equilibration
+    for (int sweepNum = sim->getFirstSweep(); sweepNum < n_updates;
+         sweepNum++) {
+        sim->runSweep(sweepNum);
+    }
+
+    std::lock_guard<std::mutex> guard(out_lock);
+    std::cout << "chain " << c << ":" << std::endl;
+    sim->finishRun();
+}
+
+// the number densities averaged over the chains and the energy over the
+// chains
+void Ensemble::writeMerged() {
+    Properties merged;
+    merged.initializeHistograms(&param);
+
+    double sum = 0;
+    double sum_sq = 0;
+    int n_chains = chains.size();
+    for (int c = 0; c < n_chains; c++) {
+        Properties *prop = chains[c]->getProperties();
+        merged.addHistograms(prop, 1.0 / n_chains);
+
+        double avg = prop->calcAvgEnergy();
+        sum = sum + avg;
+        sum_sq = sum_sq + avg * avg;
+    }
+    merged.writeHistograms();
+
+    double mean = sum / n_chains;
+    double var = (sum_sq - n_chains * mean * mean) / (n_chains - 1);
+    std::cout << "average energy over " << n_chains << " chains: " << mean
+              << " +- " << sqrt(fmax(var, 0.0) / n_chains) << std::endl;
+}
+
+// the threads of the pool take the next chain that has not been run yet
+void Ensemble::run() {
+    std::atomic<int> next(0);
+    int n_chains = chains.size();
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < n_threads; t++) {
+        pool.emplace_back([this, &next, n_chains]() {
+            for (int c = next++; c < n_chains; c = next++) {
+                runChain(c);
+            }
+        });
+    }
+    for (int t = 0; t < n_threads; t++) {
+        pool[t].join();
+    }
+
+    std::cout << n_chains << " chains on " << n_threads << " threads"
+              << std::endl;
+    writeMerged();
+}
+
+int Ensemble::getNumChains() { return chains.size(); }
+int Ensemble::getNumThreads() { return n_threads; }
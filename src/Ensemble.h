@@ -0,0 +1,42 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Parameters.h"
+#include "Properties.h"
+#include "Simulation.h"
+
+/* INDEPENDENT CHAINS
+ * ensemble_chains COPIES OF THE SAME STATE POINT, EACH WITH A SEED MIXED FROM
+ * THE YAML SEED AND ITS OWN PROPERTIES, RUN ON A POOL OF num_threads THREADS
+ * (ONE PER CORE BY DEFAULT). EVERY CHAIN WRITES ITS OWN chain<c>_ FILES, THE
+ * NUMBER DENSITIES OF ALL OF THEM ARE AVERAGED INTO THE numDensity AND
+ * xy_numDensity FILES OF THE RUN, WHICH HOLD THE COUNTS OF ONE CHAIN AS THE
+ * ANALYSIS EXPECTS THEM, AND THE SPREAD OF THE AVERAGE ENERGY OVER THE CHAINS
+ * GIVES ITS ERROR BAR
+ */
+class Ensemble {
+
+  private:
+    std::vector<std::unique_ptr<Simulation>> chains;
+    Parameters param;
+    int n_threads = 0;
+    int n_updates = 0;
+
+    std::mutex out_lock; // the chains take turns to print and write files
+
+    void runChain(int c);
+    void writeMerged();
+
+  public:
+    void initializeEnsemble(std::string yamlFile, Parameters *p);
+    void run();
+
+    int getNumChains();
+    int getNumThreads();
+};
+#endif
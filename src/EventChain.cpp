@@ -0,0 +1,183 @@
+#include <cmath>
+
+#include "EventChain.h"
+
+// back into [-L/2, L/2)
+double EventChain::wrap(double x) {
+    return x - box_L * floor(x / box_L + 0.5);
+}
+
+// finds the first disk that index runs into when it moves along dir by at most
+// max_dist. returns -1 if there is none, otherwise the disk and the distance
+// index can travel before they touch
+int EventChain::nextEvent(ParticleStore *particles, int index, int dir,
+                          double max_dist, double *free_dist) {
+    const double *par = dir == 0 ? particles->getX_Positions()
+                                 : particles->getY_Positions();
+    const double *perp = dir == 0 ? particles->getY_Positions()
+                                  : particles->getX_Positions();
+    double par_i = par[index];
+    double perp_i = perp[index];
+    double rad_i = particles->getRadius(index);
+
+    int hit = -1;
+    double best = max_dist;
+
+    // disks are touched where they overlap along the line of motion. the
+    // distance ahead is taken modulo the box, so a disk just behind is only
+    // reached after going once around. a disk level with index (touching it
+    // from the side up to round-off) is not ahead of it, otherwise the two
+    // could hand the chain back and forth without moving
+    auto visit = [&](int k) {
+        if (k == index) {
+            return;
+        }
+        double contact = sigma * (rad_i + particles->getRadius(k));
+        double b = perp[k] - perp_i;
+        b = b - box_L * floor(b / box_L + 0.5);
+        if (fabs(b) >= contact) {
+            return;
+        }
+        double ahead = par[k] - par_i;
+        ahead = ahead - box_L * floor(ahead / box_L);
+        if (ahead <= 0) {
+            return;
+        }
+        double s = fmax(ahead - sqrt(contact * contact - b * b), 0.0);
+        if (s < best) {
+            best = s;
+            hit = k;
+        }
+    };
+
+    if (!grid.isActive()) {
+        for (int k = 0; k < particles->size(); k++) {
+            visit(k);
+        }
+        *free_dist = best;
+        return hit;
+    }
+
+    // walks the strip of 3 cells wide in front of index one column at a time,
+    // until no disk further along could be hit before the best one so far
+    int n = grid.getNumCells();
+    double cell_L = box_L / n;
+    int cell = grid.getCell(index);
+    int c_par = dir == 0 ? cell / n : cell % n;
+    int c_perp = dir == 0 ? cell % n : cell / n;
+    double offset = par_i + 0.5 * box_L - c_par * cell_L;
+
+    for (int c = 0; c < n; c++) {
+        int col = (c_par + c) % n;
+        for (int dp = -1; dp <= 1; dp++) {
+            int row = (c_perp + dp + n) % n;
+            int next_cell = dir == 0 ? col * n + row : row * n + col;
+            for (int k = grid.getHead(next_cell); k != -1;
+                 k = grid.getNext(k)) {
+                visit(k);
+            }
+        }
+        // the disks in the columns left to search are at least this far
+        // ahead, less a contact distance, which is at most a cell width
+        double closest = (c + 1) * cell_L - offset - cell_L;
+        if (closest >= best) {
+            break;
+        }
+    }
+    *free_dist = best;
+    return hit;
+}
+
+void EventChain::runChain(ParticleStore *particles, int index, int dir,
+                          double length) {
+    double remaining = length;
+    while (true) {
+        double step = 0;
+        int hit = nextEvent(particles, index, dir, remaining, &step);
+        if (hit == -1) {
+            step = remaining;
+        }
+
+        double x = particles->getX_Position(index);
+        double y = particles->getY_Position(index);
+        if (dir == 0) {
+            x = wrap(x + step);
+        } else {
+            y = wrap(y + step);
+        }
+        particles->setX_Position(index, x);
+        particles->setY_Position(index, y);
+        particles->setX_TrialPos(index, x);
+        particles->setY_TrialPos(index, y);
+        grid.moveParticle(index, x, y);
+
+        if (hit == -1) {
+            break;
+        }
+        remaining = remaining - step;
+        index = hit; // the disk that was hit carries the chain on
+        ++n_events;
+    }
+    ++n_chains;
+}
+
+void EventChain::sweep(ParticleStore *particles, RNG *rand) {
+    for (int c = 0; c < chains_per_sweep; c++) {
+        int index = int(rand->RandomUniformDbl() * particles->size());
+        runChain(particles, index, direction, chain_L);
+        direction = 1 - direction;
+    }
+}
+
+bool EventChain::isActive() { return active; }
+double EventChain::getChainLength() { return chain_L; }
+int EventChain::getChainsPerSweep() { return chains_per_sweep; }
+long long EventChain::getNumChains() { return n_chains; }
+long long EventChain::getNumEvents() { return n_events; }
+
+void EventChain::saveState(CheckpointWriter *out) {
+    out->put(direction);
+    out->put(n_chains);
+    out->put(n_events);
+    grid.saveState(out);
+}
+
+void EventChain::loadState(CheckpointReader *in) {
+    in->get(&direction);
+    in->get(&n_chains);
+    in->get(&n_events);
+    grid.loadState(in);
+}
+
+// one sweep moves the disks as far in total as n_particles single moves of
+// the Metropolis step size would
+void EventChain::build(Parameters *p, ParticleStore *particles) {
+    double max_rad = 0;
+    for (int k = 0; k < particles->size(); k++) {
+        max_rad = fmax(max_rad, particles->getRadius(k));
+    }
+    grid.initializeCellList(p, 2 * max_rad * sigma);
+    grid.build(particles);
+
+    double step = particles->size() > 0 ? particles->getStepWeight(0) : 0;
+    chains_per_sweep = int(particles->size() * step / chain_L + 0.5);
+    if (chains_per_sweep < 1) {
+        chains_per_sweep = 1;
+    }
+}
+
+// event chains replace the single moves of hard disks in a periodic box
+void EventChain::initializeEventChain(Parameters *p) {
+    active = p->getEventChain() && p->getInteract_Type() == 0 &&
+             p->getBound_Type() == 1;
+    box_L = p->getBoxLength();
+    sigma = p->getSigma();
+
+    chain_L = p->getChainLength() * sigma;
+    if (chain_L <= 0) {
+        chain_L = 0.25 * box_L;
+    }
+    direction = 0;
+    n_chains = 0;
+    n_events = 0;
+}
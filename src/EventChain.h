@@ -0,0 +1,60 @@
+#ifndef EVENTCHAIN_H
+#define EVENTCHAIN_H
+
+#include "CellList.h"
+#include "Checkpoint.h"
+#include "Parameters.h"
+#include "ParticleStore.h"
+#include "RNG.h"
+
+/* EVENT-CHAIN MONTE CARLO FOR HARD DISKS
+ * INSTEAD OF SINGLE TRIAL MOVES THAT ARE REJECTED ON OVERLAP, A RANDOM DISK
+ * IS PUSHED ALONG +x OR +y UNTIL IT TOUCHES ANOTHER DISK. THE DISK IT HIT IS
+ * PUSHED ON IN THE SAME DIRECTION FOR THE REST OF THE CHAIN LENGTH, AND SO ON.
+ * NO MOVE IS EVER REJECTED. THE DIRECTION ALTERNATES BETWEEN x AND y FROM ONE
+ * CHAIN TO THE NEXT. THE DISKS THAT CAN BE HIT ARE FOUND BY WALKING ALONG
+ * THE ROW (OR COLUMN) OF CELLS IN FRONT OF THE MOVING DISK. ONLY PERIODIC
+ * BOUNDARIES ARE SUPPORTED
+ */
+class EventChain {
+
+  private:
+    bool active = false;
+    double box_L = 0;
+    double sigma = 0;
+    double chain_L = 0;      // total displacement of one chain
+    int chains_per_sweep = 0;
+    int direction = 0;       // 0 = +x, 1 = +y
+
+    CellList grid;
+
+    long long n_chains = 0;
+    long long n_events = 0; // collisions, i.e. hand-overs to another disk
+
+    double wrap(double x);
+    int nextEvent(ParticleStore *particles, int index, int dir,
+                  double max_dist, double *free_dist);
+
+  public:
+    void initializeEventChain(Parameters *p);
+
+    // indexes the disks, after the initial positions are set
+    void build(Parameters *p, ParticleStore *particles);
+
+    // chains whose lengths add up to one sweep worth of displacement
+    void sweep(ParticleStore *particles, RNG *rand);
+
+    // a single chain started by index along dir (0 = +x, 1 = +y)
+    void runChain(ParticleStore *particles, int index, int dir, double length);
+
+    bool isActive();
+    double getChainLength();
+    int getChainsPerSweep();
+    long long getNumChains();
+    long long getNumEvents();
+
+    // the cell list is loaded over the one build made for the positions
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+};
+#endif
@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "Interaction.h"
+#include "PairPotentials.h"
 #include <cmath>
 
 // returns the CHARACTERISTIC distance between two particles
@@ -8,56 +9,554 @@ double Interaction::distance(double x1, double x2, double y1, double y2) {
     return sqrt(pow(x2 - x1, 2) + pow(y2 - y1, 2)) / sigma;
 }
 
-double Interaction::lenjones_energy(double r, double a) {
-    return 4 * a * (pow(1 / r, 12) - pow(1 / r, 6) + trunc_shift);
+// CHARACTERISTIC distance to the nearest periodic image of the second
+// particle (minimum-image convention)
+double Interaction::periodicDistance(double x1, double x2, double y1,
+                                     double y2) {
+    double dx = x2 - x1;
+    double dy = y2 - y1;
+    dx = dx - box_L * floor(dx / box_L + 0.5);
+    dy = dy - box_L * floor(dy / box_L + 0.5);
+    return sqrt(dx * dx + dy * dy) / sigma;
 }
 
-// the WCA potential is not dependent upon the WCA potential
-double Interaction::WCA_energy(double r) {
-    double val = 0;
-    if (r <= pow(2.0, 1.0 / 6.0)) {
-        val = 4 * (pow(1.0 / r, 12) - pow(1.0 / r, 6) + .25);
-    }
-    return val;
+// the analytic forms are shared with the Properties class
+double Interaction::lenjones_energy(double r, double a) {
+    return potential.lenJonesEnergy(r, a);
 }
 
-// NOTE: in order for this to be in 'reduced form' the energy must
-// be multiplied by the reduced temperature. explanation will be 
-// typed up in later document
+double Interaction::WCA_energy(double r) { return potential.WCA_energy(r); }
+
 double Interaction::simple_spring_energy(double r, double a) {
-    return a * red_temp * k_spring / 2 * pow(r - rest_L, 2.0) *
-           exp(-1 * k_spring / 2.0 * pow(r - rest_L, 2.0));
+    return potential.springEnergy(r, a);
 } // NOTE: KbT = 1 so beta = 1
 
+// energy of a single pair within the truncation distance
+double Interaction::pairEnergy(double r, double a) {
+    return potential.energy(r, a);
+}
+
+PotentialTable *Interaction::getPotentialTable() { return &table; }
+DeltaKernel *Interaction::getDeltaKernel() { return &kernel; }
+bool Interaction::isTabulated() {
+    return table.isActive() && !kernel.isActive();
+}
+double Interaction::getTailCorr() { return tail_corr; }
+
+void Interaction::buildNeighborLists(ParticleStore *particles) {
+    grid.build(particles);
+    verlet.build(particles, &grid);
+
+    // the blocks never hold more than all of the particles
+    block_x.reserve(particles->size());
+    block_y.reserve(particles->size());
+    block_type.reserve(particles->size());
+}
+
+// keeps the cell list in step with an accepted move and rebuilds the verlet
+// lists once the particle has left its skin
+void Interaction::updateNeighborLists(ParticleStore *particles,
+                                      int index) {
+    double x = particles->getX_Position(index);
+    double y = particles->getY_Position(index);
+
+    grid.moveParticle(index, x, y);
+    if (verlet.isActive() && !verlet.withinSkin(index, x, y)) {
+        verlet.build(particles, &grid);
+    }
+}
+
+int Interaction::getNumListBuilds() { return verlet.getNumBuilds(); }
+CellList *Interaction::getCellList() { return &grid; }
+
+void Interaction::saveState(CheckpointWriter *out) {
+    grid.saveState(out);
+    verlet.saveState(out);
+}
+
+void Interaction::loadState(CheckpointReader *in) {
+    grid.loadState(in);
+    verlet.loadState(in);
+}
+
+// the verlet lists are left alone, they are rebuilt as a whole
+void Interaction::updateCell(ParticleStore *particles, int index) {
+    grid.moveParticle(index, particles->getX_Position(index),
+                      particles->getY_Position(index));
+}
+
+/* SUMS THE ENERGY OF PARTICLE index PLACED AT x,y WITH EVERY PARTICLE IN THE
+ * 3x3 BLOCK OF CELLS AROUND x,y. FOR PERIODIC BOUNDARIES THE CELL LIST
+ * PROVIDES THE IMAGE SHIFT OF EACH NEIGHBOURING CELL, SO ONLY THE NEAREST
+ * IMAGE OF A COMPARISON PARTICLE IS VISITED
+ */
+template <class Pair>
+double Interaction::cellEnergy(ParticleStore *particles, int index,
+                               double x, double y) {
+    int cells[9];
+    double shift_x[9];
+    double shift_y[9];
+
+    double energy = 0;
+
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+
+    int type = types[index];
+    int num = grid.neighborCells(x, y, cells, shift_x, shift_y);
+
+    for (int c = 0; c < num; c++) {
+        for (int k = grid.getHead(cells[c]); k != -1; k = grid.getNext(k)) {
+            if (k == index) {
+                continue;
+            }
+            double dx = x_pos[k] + shift_x[c] - x;
+            double dy = y_pos[k] + shift_y[c] - y;
+            double r2 = (dx * dx + dy * dy) * inv_sigma2;
+
+            if (r2 < trunc_dist2) {
+                energy = energy +
+                         Pair::energy(pair_params, r2, type != types[k]);
+            }
+        }
+    }
+    return energy;
+}
+
+// same as cellEnergy, but only the particles in the verlet list of index
+template <class Pair>
+double Interaction::verletEnergy(ParticleStore *particles, int index,
+                                 double x, double y) {
+    double energy = 0;
+
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+
+    int type = types[index];
+    int end = verlet.getEnd(index);
+
+    for (int n = verlet.getStart(index); n < end; n++) {
+        int k = verlet.getNeighbor(n);
+
+        double dx = x_pos[k] + verlet.getShiftX(n) - x;
+        double dy = y_pos[k] + verlet.getShiftY(n) - y;
+        double r2 = (dx * dx + dy * dy) * inv_sigma2;
+
+        if (r2 < trunc_dist2) {
+            energy = energy + Pair::energy(pair_params, r2, type != types[k]);
+        }
+    }
+    return energy;
+}
+
+/* CHANGE IN ENERGY OF A TRIAL MOVE FROM THE NEIGHBOUR STRUCTURES
+ * THE CURRENT POSITION IS ALWAYS COVERED BY THE VERLET LIST. A TRIAL POSITION
+ * MORE THAN HALF A SKIN AWAY FROM THE REFERENCE POSITION MAY SEE PARTICLES
+ * OUTSIDE OF THE LIST, SO IT FALLS BACK ON THE CELL LIST
+ */
+template <class Pair>
+double Interaction::neighborDeltaT(ParticleStore *particles,
+                                   int index) {
+    double x_temp = particles->getX_TrialPos(index);
+    double y_temp = particles->getY_TrialPos(index);
+    double x_curr = particles->getX_Position(index);
+    double y_curr = particles->getY_Position(index);
+
+    if (!verlet.isActive()) {
+        return cellEnergy<Pair>(particles, index, x_temp, y_temp) -
+               cellEnergy<Pair>(particles, index, x_curr, y_curr);
+    }
+
+    double energy_temp = 0;
+    if (verlet.withinSkin(index, x_temp, y_temp)) {
+        energy_temp = verletEnergy<Pair>(particles, index, x_temp, y_temp);
+    } else {
+        energy_temp = cellEnergy<Pair>(particles, index, x_temp, y_temp);
+    }
+    return energy_temp - verletEnergy<Pair>(particles, index, x_curr, y_curr);
+}
+
+template <class Pair>
+double Interaction::cellDeltaT(ParticleStore *particles, int index) {
+    return cellEnergy<Pair>(particles, index, particles->getX_TrialPos(index),
+                            particles->getY_TrialPos(index)) -
+           cellEnergy<Pair>(particles, index, particles->getX_Position(index),
+                            particles->getY_Position(index));
+}
+
+// the versions for the pair potential chosen at startup
+double Interaction::neighborDelta(ParticleStore *particles,
+                                  int index) {
+    return (this->*neighbor_delta)(particles, index);
+}
+
+double Interaction::cellDelta(ParticleStore *particles, int index) {
+    return (this->*cell_delta)(particles, index);
+}
+
+double Interaction::minImageInteraction(ParticleStore *particles,
+                                        int index) {
+    return (this->*min_image_delta)(particles, index);
+}
+
+/////////// VECTORIZED KERNEL ////////////////
+
+KernelMove Interaction::kernelMove(ParticleStore *particles, int index) {
+    KernelMove m;
+    m.type = particles->getType(index);
+    m.x_temp = particles->getX_TrialPos(index);
+    m.y_temp = particles->getY_TrialPos(index);
+    m.x_curr = particles->getX_Position(index);
+    m.y_curr = particles->getY_Position(index);
+    return m;
+}
+
+// copies the verlet list of index, with its image shifts, into the blocks
+int Interaction::gatherVerlet(ParticleStore *particles, int index) {
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+
+    block_x.clear();
+    block_y.clear();
+    block_type.clear();
+    int end = verlet.getEnd(index);
+    for (int n = verlet.getStart(index); n < end; n++) {
+        int k = verlet.getNeighbor(n);
+        block_x.push_back(x_pos[k] + verlet.getShiftX(n));
+        block_y.push_back(y_pos[k] + verlet.getShiftY(n));
+        block_type.push_back(types[k]);
+    }
+    return block_x.size();
+}
+
+// copies the particles of the 3x3 block of cells around x,y, except index,
+// into the blocks
+int Interaction::gatherCells(ParticleStore *particles, int index, double x,
+                             double y) {
+    int cells[9];
+    double shift_x[9];
+    double shift_y[9];
+
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+
+    block_x.clear();
+    block_y.clear();
+    block_type.clear();
+    int num = grid.neighborCells(x, y, cells, shift_x, shift_y);
+    for (int c = 0; c < num; c++) {
+        for (int k = grid.getHead(cells[c]); k != -1; k = grid.getNext(k)) {
+            if (k == index) {
+                continue;
+            }
+            block_x.push_back(x_pos[k] + shift_x[c]);
+            block_y.push_back(y_pos[k] + shift_y[c]);
+            block_type.push_back(types[k]);
+        }
+    }
+    return block_x.size();
+}
+
+// every other particle, which sits on either side of index in the store
+double Interaction::kernelAllPairs(ParticleStore *particles, int index,
+                                   bool wrap) {
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+
+    KernelMove m = kernelMove(particles, index);
+    int rest = n_particles - index - 1;
+    if (wrap) {
+        return kernel.wrappedDelta(x_pos, y_pos, types, index, m) +
+               kernel.wrappedDelta(x_pos + index + 1, y_pos + index + 1,
+                                   types + index + 1, rest, m);
+    }
+    return kernel.delta(x_pos, y_pos, types, index, m) +
+           kernel.delta(x_pos + index + 1, y_pos + index + 1,
+                        types + index + 1, rest, m);
+}
+
+double Interaction::kernelMinImageDelta(ParticleStore *particles, int index) {
+    return kernelAllPairs(particles, index, true);
+}
+
+/* THE KERNEL NEEDS ONE BLOCK OF NEIGHBOURS FOR BOTH POSITIONS. THE VERLET
+ * LIST IS SUCH A BLOCK WHILE THE TRIAL POSITION IS WITHIN HALF A SKIN, AND THE
+ * 3x3 CELLS AROUND THE CURRENT POSITION WHILE THE TRIAL POSITION IS IN THE
+ * SAME CELL. OTHERWISE THE SCALAR LOOPS ARE USED
+ */
+template <class Pair>
+double Interaction::kernelNeighborDelta(ParticleStore *particles, int index) {
+    KernelMove m = kernelMove(particles, index);
+
+    if (verlet.isActive()) {
+        if (!verlet.withinSkin(index, m.x_temp, m.y_temp)) {
+            return neighborDeltaT<Pair>(particles, index);
+        }
+        int n = gatherVerlet(particles, index);
+        return kernel.delta(block_x.data(), block_y.data(), block_type.data(),
+                            n, m);
+    }
+
+    if (grid.cellIndex(m.x_temp, m.y_temp) != grid.getCell(index)) {
+        return neighborDeltaT<Pair>(particles, index);
+    }
+    int n = gatherCells(particles, index, m.x_curr, m.y_curr);
+    return kernel.delta(block_x.data(), block_y.data(), block_type.data(), n,
+                        m);
+}
+
+/////////// ENERGIES OF WHOLE PARTICLES ////////////////
+
+/* CALLS visit(k, u) FOR EVERY PARTICLE k WITHIN THE TRUNCATION DISTANCE OF
+ * PARTICLE index PLACED AT x,y, WITH u THE ENERGY OF THE PAIR. WITH A CUTOFF
+ * LONGER THAN HALF THE BOX EVERY IMAGE WITHIN RANGE IS VISITED
+ */
+template <class Pair, class Visit>
+void Interaction::forEachPair(ParticleStore *particles, int index, double x,
+                              double y, Visit visit) {
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+    int type = types[index];
+
+    if (grid.isActive()) {
+        int cells[9];
+        double shift_x[9];
+        double shift_y[9];
+        int num = grid.neighborCells(x, y, cells, shift_x, shift_y);
+
+        for (int c = 0; c < num; c++) {
+            for (int k = grid.getHead(cells[c]); k != -1;
+                 k = grid.getNext(k)) {
+                double dx = x_pos[k] + shift_x[c] - x;
+                double dy = y_pos[k] + shift_y[c] - y;
+                double r2 = (dx * dx + dy * dy) * inv_sigma2;
+                if (k != index && r2 < trunc_dist2) {
+                    visit(k, Pair::energy(pair_params, r2, type != types[k]));
+                }
+            }
+        }
+        return;
+    }
+
+    int n_images = (periodic && !min_image) ? 3 : 1;
+    for (int k = 0; k < n_particles; k++) {
+        if (k == index) {
+            continue;
+        }
+        double dx = x_pos[k] - x;
+        double dy = y_pos[k] - y;
+        if (periodic) {
+            dx = dx - box_L * floor(dx / box_L + 0.5);
+            dy = dy - box_L * floor(dy / box_L + 0.5);
+        }
+        for (int i = 0; i < n_images * n_images; i++) {
+            double sx = (n_images > 1) ? (i / 3 - 1) * box_L : 0;
+            double sy = (n_images > 1) ? (i % 3 - 1) * box_L : 0;
+            double r2 =
+                ((dx + sx) * (dx + sx) + (dy + sy) * (dy + sy)) * inv_sigma2;
+            if (r2 < trunc_dist2) {
+                visit(k, Pair::energy(pair_params, r2, type != types[k]));
+            }
+        }
+    }
+}
+
+// sum of the pair energies of index at its current position
+template <class Pair>
+double Interaction::particleEnergyT(ParticleStore *particles, int index) {
+    double energy = 0;
+    forEachPair<Pair>(particles, index, particles->getX_Position(index),
+                      particles->getY_Position(index),
+                      [&](int k, double u) { energy = energy + u; });
+    return energy;
+}
+
+// adds the change of every pair energy of an accepted move of index, half to
+// each particle of the pair. called before the trial position is taken over
+template <class Pair>
+void Interaction::spreadDeltaT(ParticleStore *particles, int index,
+                               double *energies) {
+    forEachPair<Pair>(particles, index, particles->getX_TrialPos(index),
+                      particles->getY_TrialPos(index), [&](int k, double u) {
+                          energies[k] = energies[k] + 0.5 * u;
+                          energies[index] = energies[index] + 0.5 * u;
+                      });
+    forEachPair<Pair>(particles, index, particles->getX_Position(index),
+                      particles->getY_Position(index), [&](int k, double u) {
+                          energies[k] = energies[k] - 0.5 * u;
+                          energies[index] = energies[index] - 0.5 * u;
+                      });
+}
+
+template <class Pair>
+void Interaction::pairEnergiesT(ParticleStore *particles, int index, double x,
+                                double y, std::vector<int> *others,
+                                std::vector<double> *energies) {
+    forEachPair<Pair>(particles, index, x, y, [&](int k, double u) {
+        others->push_back(k);
+        energies->push_back(u);
+    });
+}
+
+double Interaction::particleEnergy(ParticleStore *particles, int index) {
+    return (this->*particle_energy)(particles, index);
+}
+
+// total pair energy of the configuration. if energies is given it receives
+// the energy of each particle (half of each of its pairs)
+double Interaction::totalEnergy(ParticleStore *particles, double *energies) {
+    double total = 0;
+    for (int k = 0; k < n_particles; k++) {
+        double half = 0.5 * particleEnergy(particles, k);
+        if (energies != nullptr) {
+            energies[k] = half;
+        }
+        total = total + half;
+    }
+    return total;
+}
+
+void Interaction::spreadDelta(ParticleStore *particles, int index,
+                              double *energies) {
+    (this->*spread_delta)(particles, index, energies);
+}
+
+void Interaction::pairEnergies(ParticleStore *particles, int index, double x,
+                               double y, std::vector<int> *others,
+                               std::vector<double> *energies) {
+    (this->*pair_energies)(particles, index, x, y, others, energies);
+}
+
+template <class Pair> void Interaction::setPairPolicy() {
+    neighbor_delta = &Interaction::neighborDeltaT<Pair>;
+    min_image_delta = &Interaction::minImageDeltaT<Pair>;
+    particle_energy = &Interaction::particleEnergyT<Pair>;
+    cell_delta = &Interaction::cellDeltaT<Pair>;
+    spread_delta = &Interaction::spreadDeltaT<Pair>;
+    pair_energies = &Interaction::pairEnergiesT<Pair>;
+
+    if (kernel.isActive()) {
+        neighbor_delta = &Interaction::kernelNeighborDelta<Pair>;
+        min_image_delta = &Interaction::kernelMinImageDelta;
+    }
+}
+
+// picks the pair potential once, so the pair loops never switch on it. the
+// kernel uses the analytic forms, so its scalar fallbacks do the same
+void Interaction::selectPairPolicy() {
+    if (isTabulated()) {
+        setPairPolicy<TabulatedPair>();
+        return;
+    }
+    switch (interact_type) {
+    case 1:
+        setPairPolicy<LennardJonesPair>();
+        break;
+    case 2:
+        setPairPolicy<WCAPair>();
+        break;
+    case 3:
+        setPairPolicy<WCASpringPair>();
+        break;
+    default:
+        setPairPolicy<HardDiskPair>();
+        break;
+    }
+}
+
 void Interaction::populateCellArray(
-    double x, double y, std::vector<std::vector<double>> *cellPositions) {
+    double x, double y, double cellPositions[][2]) {
 
     // account for the periodic images of the 'parent' cell
-    (*cellPositions)[0][0] = x;
-    (*cellPositions)[0][1] = y;
-    (*cellPositions)[1][0] = x;
-    (*cellPositions)[1][1] = y + box_L;
-    (*cellPositions)[2][0] = x;
-    (*cellPositions)[2][1] = y - box_L;
-    (*cellPositions)[3][0] = x + box_L;
-    (*cellPositions)[3][1] = y;
-    (*cellPositions)[4][0] = x + box_L;
-    (*cellPositions)[4][1] = y + box_L;
-    (*cellPositions)[5][0] = x + box_L;
-    (*cellPositions)[5][1] = y - box_L;
-    (*cellPositions)[6][0] = x - box_L;
-    (*cellPositions)[6][1] = y;
-    (*cellPositions)[7][0] = x - box_L;
-    (*cellPositions)[7][1] = y + box_L;
-    (*cellPositions)[8][0] = x - box_L;
-    (*cellPositions)[8][1] = y - box_L;
-}
-
-double Interaction::periodicInteraction(std::vector<Particle> *particles,
+    cellPositions[0][0] = x;
+    cellPositions[0][1] = y;
+    cellPositions[1][0] = x;
+    cellPositions[1][1] = y + box_L;
+    cellPositions[2][0] = x;
+    cellPositions[2][1] = y - box_L;
+    cellPositions[3][0] = x + box_L;
+    cellPositions[3][1] = y;
+    cellPositions[4][0] = x + box_L;
+    cellPositions[4][1] = y + box_L;
+    cellPositions[5][0] = x + box_L;
+    cellPositions[5][1] = y - box_L;
+    cellPositions[6][0] = x - box_L;
+    cellPositions[6][1] = y;
+    cellPositions[7][0] = x - box_L;
+    cellPositions[7][1] = y + box_L;
+    cellPositions[8][0] = x - box_L;
+    cellPositions[8][1] = y - box_L;
+}
+
+/* CHANGE IN ENERGY WITH PERIODIC BOUNDARIES FROM THE NEAREST IMAGE OF EVERY
+ * PARTICLE. WHEN THE TRUNCATION DISTANCE IS AT MOST HALF THE BOX, AT MOST ONE
+ * IMAGE OF A PARTICLE CAN BE WITHIN RANGE, SO THIS GIVES THE SAME ENERGY AS
+ * THE SUM OVER ALL 9 IMAGES
+ */
+template <class Pair>
+double Interaction::minImageDeltaT(ParticleStore *particles,
+                                   int index) {
+    double delta_energy = 0;
+
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+
+    double x_temp = particles->getX_TrialPos(index);
+    double y_temp = particles->getY_TrialPos(index);
+    double x_curr = x_pos[index];
+    double y_curr = y_pos[index];
+    int type = types[index];
+
+    for (int k = 0; k < n_particles; k++) {
+        if (k == index) {
+            continue;
+        }
+        int kind = (type != types[k]);
+
+        double x_comp = x_pos[k];
+        double y_comp = y_pos[k];
+
+        double dx = x_comp - x_temp;
+        double dy = y_comp - y_temp;
+        dx = dx - box_L * floor(dx / box_L + 0.5);
+        dy = dy - box_L * floor(dy / box_L + 0.5);
+        double r2_temp = (dx * dx + dy * dy) * inv_sigma2;
+
+        dx = x_comp - x_curr;
+        dy = y_comp - y_curr;
+        dx = dx - box_L * floor(dx / box_L + 0.5);
+        dy = dy - box_L * floor(dy / box_L + 0.5);
+        double r2_curr = (dx * dx + dy * dy) * inv_sigma2;
+
+        if (r2_temp < trunc_dist2) {
+            delta_energy =
+                delta_energy + Pair::energy(pair_params, r2_temp, kind);
+        }
+        if (r2_curr < trunc_dist2) {
+            delta_energy =
+                delta_energy - Pair::energy(pair_params, r2_curr, kind);
+        }
+    }
+    return delta_energy;
+}
+
+double Interaction::periodicInteraction(ParticleStore *particles,
                                         int index) {
-    Particle current_prt;
-    Particle compare_prt;
+    // with a cell list only the neighbouring cells have to be visited
+    if (grid.isActive()) {
+        return neighborDelta(particles, index) + tail_corr;
+    } else if (min_image) {
+        return minImageInteraction(particles, index) + tail_corr;
+    }
 
+    // the cutoff is longer than half the box: sum over the explicit images
     double delta_energy = 0;
     double energy_curr = 0;
     double energy_temp = 0;
@@ -65,21 +564,18 @@ double Interaction::periodicInteraction(std::vector<Particle> *particles,
     double num = 0;
     double a = 0; // a is the binding affinity associated with
 
-    std::vector<std::vector<double>> cellPositions(9,
-                                                   std::vector<double>(2, 0));
+    double cellPositions[9][2] = {}; // the images of the other particle
 
-    current_prt = (*particles)[index]; // assign current particle
+    int type = particles->getType(index);
 
-    double x_temp = current_prt.getX_TrialPos(); // assign the current and trial
-    double y_temp = current_prt.getY_TrialPos(); // positions of the current
-                                                 // particle
-    double x_curr = current_prt.getX_Position();
-    double y_curr = current_prt.getY_Position();
+    double x_temp = particles->getX_TrialPos(index); // assign the current and
+    double y_temp = particles->getY_TrialPos(index); // trial positions of the
+                                                     // current particle
+    double x_curr = particles->getX_Position(index);
+    double y_curr = particles->getY_Position(index);
 
     for (int k = 0; k < n_particles; k++) {
 
-        compare_prt = (*particles)[k]; // assign the comparison particle
-
         /* - CHECK THAT THE COMPARISON PARTICLE IS NOT THE CURRENT PARTICLE
            - SET THE COMPARISON POSITION AND RADIUS
            - COMPUTE THE CURRENT DISTANCE BETWEEN THE TWO PARTICLES
@@ -92,18 +588,18 @@ double Interaction::periodicInteraction(std::vector<Particle> *particles,
              FOR THE PARTICLE IN RELATION TO PARTICLE INTERACTIONS
         */
 
-        if (current_prt.getIdentifier() != compare_prt.getIdentifier()) {
+        if (k != index) {
 
             // type == type: interaction between parallel particles
             // type != type: interaction between antiparallel particles
-            if (current_prt.getType() == compare_prt.getType()) {
+            if (type == particles->getType(k)) {
                 a = a_ref;
-            } else if (current_prt.getType() != compare_prt.getType()) {
+            } else {
                 a = a_ref * a_mult;
             }
 
-            double x_comp = compare_prt.getX_Position(); // set the comparison
-            double y_comp = compare_prt.getY_Position(); // particles position
+            double x_comp = particles->getX_Position(k); // set the comparison
+            double y_comp = particles->getY_Position(k); // particles position
 
             double dist_curr_tot = distance(x_curr, x_comp, y_curr, y_comp);
             double dist_temp_tot = distance(x_temp, x_comp, y_temp, y_comp);
@@ -120,7 +616,7 @@ double Interaction::periodicInteraction(std::vector<Particle> *particles,
 
             if (dist_curr_tot > trunc_dist || dist_temp_tot > trunc_dist) {
 
-                populateCellArray(x_comp, y_comp, &cellPositions);
+                populateCellArray(x_comp, y_comp, cellPositions);
                 for (int z = 0; z < 9; z++) {
                     // creates the 'phantom' particles in the other cell images
                     x_comp = cellPositions[z][0];
@@ -209,10 +705,13 @@ double Interaction::periodicInteraction(std::vector<Particle> *particles,
     return delta_energy + tail_corr; // returns the total change in energy
 }
 
-double Interaction::nonPeriodicInteraction(std::vector<Particle> *particles,
+double Interaction::nonPeriodicInteraction(ParticleStore *particles,
                                            int index) {
-    Particle current_prt;
-    Particle compare_prt;
+    if (grid.isActive()) {
+        return neighborDelta(particles, index);
+    } else if (kernel.isActive()) {
+        return kernelAllPairs(particles, index, false);
+    }
 
     double delta_energy = 0;
     double energy_curr = 0;
@@ -220,28 +719,26 @@ double Interaction::nonPeriodicInteraction(std::vector<Particle> *particles,
 
     double a = 0; // a is the binding affinity associated with the
 
-    current_prt = (*particles)[index]; // assign current particle
+    int type = particles->getType(index);
 
-    double x_temp = current_prt.getX_TrialPos(); // assign the current and trial
-    double y_temp = current_prt.getY_TrialPos(); // positions of the current
-                                                 // particle
-    double x_curr = current_prt.getX_Position();
-    double y_curr = current_prt.getY_Position();
+    double x_temp = particles->getX_TrialPos(index); // assign the current and
+    double y_temp = particles->getY_TrialPos(index); // trial positions of the
+                                                     // current particle
+    double x_curr = particles->getX_Position(index);
+    double y_curr = particles->getY_Position(index);
 
     for (int k = 0; k < n_particles; k++) {
-        compare_prt = (*particles)[k];
-
-        if (compare_prt.getIdentifier() != current_prt.getIdentifier()) {
+        if (k != index) {
 
             // interaction between like if type == type, unlike if type != type
-            if (current_prt.getType() == compare_prt.getType()) {
+            if (type == particles->getType(k)) {
                 a = a_ref;
-            } else if (current_prt.getType() != compare_prt.getType()) {
+            } else {
                 a = a_ref * a_mult;
             }
 
-            double x_comp = compare_prt.getX_Position(); // set the comparison
-            double y_comp = compare_prt.getY_Position(); // particles position
+            double x_comp = particles->getX_Position(k); // set the comparison
+            double y_comp = particles->getY_Position(k); // particles position
 
             double dist_curr_tot = distance(x_curr, x_comp, y_curr, y_comp);
             double dist_temp_tot = distance(x_temp, x_comp, y_temp, y_comp);
@@ -288,10 +785,7 @@ double Interaction::nonPeriodicInteraction(std::vector<Particle> *particles,
     return delta_energy;
 }
 
-bool Interaction::hardDisks(std::vector<Particle> *particles, int index) {
-
-    Particle current_prt;
-    Particle compare_prt;
+bool Interaction::hardDisks(ParticleStore *particles, int index) {
 
     double x_temp = 0;
     double y_temp = 0;
@@ -304,29 +798,32 @@ bool Interaction::hardDisks(std::vector<Particle> *particles, int index) {
 
     bool accept = 0;
 
-    current_prt = (*particles)[index]; // assign the current particle
-
-    x_temp = current_prt.getX_TrialPos(); // assign x,y trial position
-    y_temp = current_prt.getY_TrialPos(); // and the radius of the current
-    rad_temp = current_prt.getRadius();   // particle
+    x_temp = particles->getX_TrialPos(index); // assign x,y trial position
+    y_temp = particles->getY_TrialPos(index); // and the radius of the
+    rad_temp = particles->getRadius(index);   // current particle
 
     accept = 1;
     //////// CHECK FOR PARTICLE-PARTICLE COLLISION //////////
 
     for (int k = 0; k < n_particles; k++) {
 
-        compare_prt = (*particles)[k]; // compare all particles positions
-                                       // to current particle's position
-        if (current_prt.getIdentifier() != compare_prt.getIdentifier()) {
+        // compare all particles positions to current particle's position
+        if (k != index) {
 
-            x_comp = compare_prt.getX_Position();
-            y_comp = compare_prt.getY_Position();
-            rad_comp = compare_prt.getRadius();
+            x_comp = particles->getX_Position(k);
+            y_comp = particles->getY_Position(k);
+            rad_comp = particles->getRadius(k);
+
+            double dist = 0;
+            if (periodic) {
+                dist = periodicDistance(x_temp, x_comp, y_temp, y_comp);
+            } else {
+                dist = distance(x_temp, x_comp, y_temp, y_comp);
+            }
 
             // if curr_part center is closer than the radius of the
             // current particle plus the radius of comp_part, reject
-            if (distance(x_temp, x_comp, y_temp, y_comp) <
-                rad_comp + rad_temp) {
+            if (dist < rad_comp + rad_temp) {
                 accept = 0;
                 break;
             }
@@ -336,17 +833,10 @@ bool Interaction::hardDisks(std::vector<Particle> *particles, int index) {
 }
 
 void Interaction::truncation_values() {
-    switch (interact_type) {
-    case 3:
-        trunc_dist = .5 * box_L;
-        break;
-    default:
-        trunc_dist = 2.5;
-        trunc_shift = -1 * (pow(1 / trunc_dist, 12) - pow(1 / trunc_dist, 6));
-        tail_corr = 3.141592654 * red_dens *
-                    (.4 * pow(1 / trunc_dist, 10) - pow(1 / trunc_dist, 4));
-        break;
-    }
+    trunc_dist = potential.getTruncDist();
+    trunc_shift = potential.getTruncShift();
+    tail_corr = potential.getTailCorr();
+    trunc_dist2 = trunc_dist * trunc_dist;
 }
 // assign all private variables used in this class
 void Interaction::initializeInteraction(Parameters *p) {
@@ -363,6 +853,22 @@ void Interaction::initializeInteraction(Parameters *p) {
 
     a_ref = p->getRefAffinity();
     a_mult = p->getAffinityMult();
+    inv_sigma2 = 1 / (sigma * sigma);
+
+    potential.initializePotential(p);
+    table.initializeTable(p, &potential);
+    pair_params.initializePairParams(p, &potential, &table);
+    if (p->getDeltaKernel() > 0) {
+        kernel.initializeDeltaKernel(p, &potential, p->getDeltaKernel() - 1);
+    }
+    selectPairPolicy();
     truncation_values();
+
+    periodic = (p->getBound_Type() == 1);
+    min_image = (trunc_dist * sigma <= 0.5 * box_L);
+
+    // cells are at least one truncation distance (plus the verlet skin) wide
+    grid.initializeCellList(p, (trunc_dist + p->getVerletSkin()) * sigma);
+    verlet.initializeVerletList(p, trunc_dist * sigma);
 }
 
@@ -3,8 +3,14 @@
 
 #include <vector>
 
+#include "CellList.h"
+#include "Checkpoint.h"
+#include "DeltaKernel.h"
 #include "Parameters.h"
-#include "Particle.h"
+#include "PairPotentials.h"
+#include "ParticleStore.h"
+#include "Potential.h"
+#include "VerletList.h"
 #include "kiss.h"
 
 class Interaction {
@@ -26,23 +32,120 @@ class Interaction {
     double tail_corr = 0;
     double trunc_dist = 0;
     double trunc_shift = 0;
+    double trunc_dist2 = 0;
+    double inv_sigma2 = 0;
 
     double box_L = 0;
     int n_particles = 0;
 
+    bool periodic = false;
+    bool min_image = false; // true if the cutoff is at most half the box
+
+    Potential potential;
+    PotentialTable table;
+    PairParams pair_params;
+
+    // pair loops instantiated for the pair potential chosen at startup
+    double (Interaction::*neighbor_delta)(ParticleStore *, int) = nullptr;
+    double (Interaction::*min_image_delta)(ParticleStore *, int) = nullptr;
+    double (Interaction::*particle_energy)(ParticleStore *, int) = nullptr;
+    double (Interaction::*cell_delta)(ParticleStore *, int) = nullptr;
+    void (Interaction::*spread_delta)(ParticleStore *, int, double *) =
+        nullptr;
+    void (Interaction::*pair_energies)(ParticleStore *, int, double, double,
+                                       std::vector<int> *,
+                                       std::vector<double> *) = nullptr;
+
+    template <class Pair> void setPairPolicy();
+    template <class Pair>
+    double cellEnergy(ParticleStore *particles, int index, double x, double y);
+    template <class Pair>
+    double verletEnergy(ParticleStore *particles, int index, double x,
+                        double y);
+    template <class Pair>
+    double neighborDeltaT(ParticleStore *particles, int index);
+    template <class Pair>
+    double minImageDeltaT(ParticleStore *particles, int index);
+    template <class Pair>
+    double cellDeltaT(ParticleStore *particles, int index);
+
+    // energies of whole particles, for the running total energy
+    template <class Pair, class Visit>
+    void forEachPair(ParticleStore *particles, int index, double x, double y,
+                     Visit visit);
+    template <class Pair>
+    double particleEnergyT(ParticleStore *particles, int index);
+    template <class Pair>
+    void spreadDeltaT(ParticleStore *particles, int index, double *energies);
+    template <class Pair>
+    void pairEnergiesT(ParticleStore *particles, int index, double x,
+                       double y, std::vector<int> *others,
+                       std::vector<double> *energies);
+
+    // the vectorized kernel works on neighbours gathered into these blocks
+    DeltaKernel kernel;
+    std::vector<double> block_x;
+    std::vector<double> block_y;
+    std::vector<int> block_type;
+
+    KernelMove kernelMove(ParticleStore *particles, int index);
+    int gatherVerlet(ParticleStore *particles, int index);
+    int gatherCells(ParticleStore *particles, int index, double x, double y);
+    double kernelAllPairs(ParticleStore *particles, int index, bool wrap);
+    template <class Pair>
+    double kernelNeighborDelta(ParticleStore *particles, int index);
+    double kernelMinImageDelta(ParticleStore *particles, int index);
+
+    CellList grid; // spatial index over the accepted positions
+    VerletList verlet;
+
   public:
     void initializeInteraction(Parameters *p);
-    void populateCellArray(double x, double y,
-                           std::vector<std::vector<double>> *cellPositions);
+    void populateCellArray(double x, double y, double cellPositions[][2]);
     void truncation_values();
 
     double distance(double x1, double x2, double y1, double y2);
+    double periodicDistance(double x1, double x2, double y1, double y2);
     double lenjones_energy(double r, double a);
     double WCA_energy(double r);
     double simple_spring_energy(double r, double a);
+    double pairEnergy(double r, double a);
+    PotentialTable *getPotentialTable();
+    DeltaKernel *getDeltaKernel();
+    // the pair loops use the table, which the delta-energy kernel does not
+    bool isTabulated();
+    double getTailCorr();
+
+    double particleEnergy(ParticleStore *particles, int index);
+    double totalEnergy(ParticleStore *particles, double *energies);
+    void spreadDelta(ParticleStore *particles, int index, double *energies);
+
+    // appends every particle within the cutoff of index placed at x,y and
+    // the energy of the pair (summed over images)
+    void pairEnergies(ParticleStore *particles, int index, double x, double y,
+                      std::vector<int> *others, std::vector<double> *energies);
+
+    void buildNeighborLists(ParticleStore *particles);
+    void updateNeighborLists(ParticleStore *particles, int index);
+    int getNumListBuilds();
+    CellList *getCellList();
+
+    // the neighbour structures as the moves so far have left them
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+
+    // the change in energy of a trial move and the update after an accepted
+    // one from the cell list alone. they only touch the cells around the
+    // particle, so moves in cells far enough apart can run at the same time
+    double cellDelta(ParticleStore *particles, int index);
+    void updateCell(ParticleStore *particles, int index);
+
+    void selectPairPolicy();
+    double neighborDelta(ParticleStore *particles, int index);
 
-    double nonPeriodicInteraction(std::vector<Particle> *particles, int index);
-    double periodicInteraction(std::vector<Particle> *particles, int index);
-    bool hardDisks(std::vector<Particle> *particles, int index);
+    double nonPeriodicInteraction(ParticleStore *particles, int index);
+    double periodicInteraction(ParticleStore *particles, int index);
+    double minImageInteraction(ParticleStore *particles, int index);
+    bool hardDisks(ParticleStore *particles, int index);
 };
 #endif
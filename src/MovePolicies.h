@@ -0,0 +1,77 @@
+#ifndef MOVEPOLICIES_H
+#define MOVEPOLICIES_H
+
+#include "Boundary.h"
+#include "Interaction.h"
+#include "ParticleStore.h"
+
+/* TRIAL MOVE POLICIES
+ * THE SWEEP OF SINGLE PARTICLE MOVES IS A TEMPLATE OVER ONE BOUNDARY POLICY
+ * (boundaryType) AND ONE INTERACTION POLICY (HARD DISKS OR SOFT PAIRS), SO
+ * THE MOVE LOOP IS INSTANTIATED ONCE PER COMBINATION AND CHOSEN ONCE AT
+ * STARTUP, LIKE THE PAIR LOOPS ARE FOR THE PAIR POTENTIALS. WHICH SOFT PAIR
+ * POTENTIAL IS USED IS ALREADY SETTLED INSIDE Interaction. A POLICY RETURNS
+ * FALSE TO REJECT THE MOVE OUTRIGHT AND OTHERWISE ADDS ITS PART OF THE
+ * CHANGE IN ENERGY TO delta_energy
+ */
+
+// boundaryType 0: moves across the walls are rejected
+struct RigidWalls {
+    static const bool periodic = false;
+    static bool trial(Boundary *bound, ParticleStore *particles, int index,
+                      double *delta_energy) {
+        (void)delta_energy;
+        return bound->rigidBoundary(particles, index);
+    }
+};
+
+// boundaryType 1: the trial position is wrapped back into the box
+struct PeriodicBox {
+    static const bool periodic = true;
+    static bool trial(Boundary *bound, ParticleStore *particles, int index,
+                      double *delta_energy) {
+        (void)delta_energy;
+        bound->periodicBoundary(particles, index);
+        return true;
+    }
+};
+
+// boundaryType 2: the harmonic well adds to the change in energy
+struct HarmonicWell {
+    static const bool periodic = false;
+    static bool trial(Boundary *bound, ParticleStore *particles, int index,
+                      double *delta_energy) {
+        *delta_energy = *delta_energy + bound->externalWell(particles, index);
+        return true;
+    }
+};
+
+// interactionType 0: a move is allowed if the disk overlaps no other
+struct HardDiskMoves {
+    template <class Bound>
+    static bool trial(Interaction *interact, ParticleStore *particles,
+                      int index, double *delta_energy, double *pair_delta) {
+        (void)delta_energy;
+        (void)pair_delta;
+        return interact->hardDisks(particles, index);
+    }
+};
+
+// interactionType 1 - 3: the change in pair energy, with the tail correction
+// in the periodic box. pair_delta is the part from the pairs alone
+struct SoftPairMoves {
+    template <class Bound>
+    static bool trial(Interaction *interact, ParticleStore *particles,
+                      int index, double *delta_energy, double *pair_delta) {
+        if (Bound::periodic) {
+            double delta = interact->periodicInteraction(particles, index);
+            *pair_delta = delta - interact->getTailCorr();
+            *delta_energy = *delta_energy + delta;
+        } else {
+            *pair_delta = interact->nonPeriodicInteraction(particles, index);
+            *delta_energy = *delta_energy + *pair_delta;
+        }
+        return true;
+    }
+};
+#endif
@@ -0,0 +1,308 @@
+#include <cmath>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "OutputWriter.h"
+
+/////////////// WRITER ////////////////
+
+OutputWriter::~OutputWriter() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    wake.notify_one();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void OutputWriter::initializeOutputWriter(Parameters *p) {
+    if (p->getOutputBuffer() > 0) {
+        buffer_size = std::size_t(p->getOutputBuffer()) * 1024;
+    }
+}
+
+std::size_t OutputWriter::getBufferSize() { return buffer_size; }
+
+// room in the ring for the buffers of one more file, and the thread with the
+// first file, so nothing is allocated once the files are open
+void OutputWriter::attach() {
+    std::lock_guard<std::mutex> guard(lock);
+    n_files++;
+    if (jobs.size() < std::size_t(2 * n_files)) {
+        std::vector<Job> ring(2 * n_files);
+        for (std::size_t j = 0; j < n_jobs; j++) {
+            ring[j] = jobs[(first + j) % jobs.size()];
+        }
+        jobs.swap(ring);
+        first = 0;
+    }
+    if (!thread.joinable()) {
+        thread = std::thread(&OutputWriter::work, this);
+    }
+}
+
+void OutputWriter::detach() {
+    std::lock_guard<std::mutex> guard(lock);
+    n_files--;
+}
+
+void OutputWriter::submit(OutputFile *file, const char *data,
+                          std::size_t n) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        jobs[(first + n_jobs) % jobs.size()] = Job{file, data, n};
+        n_jobs++;
+        file->in_flight++;
+    }
+    wake.notify_one();
+}
+
+void OutputWriter::waitFor(OutputFile *file, int n) {
+    std::unique_lock<std::mutex> guard(lock);
+    if (file->in_flight <= n) {
+        return;
+    }
+    std::chrono::steady_clock::time_point wait_start =
+        std::chrono::steady_clock::now();
+    done.wait(guard, [file, n]() { return file->in_flight <= n; });
+    blocked_time =
+        blocked_time + (std::chrono::steady_clock::now() - wait_start);
+}
+
+// the jobs in the order they came, each written whole before the next
+void OutputWriter::work() {
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        wake.wait(guard, [this]() { return stop || n_jobs > 0; });
+        if (n_jobs == 0) {
+            return;
+        }
+        Job job = jobs[first];
+        guard.unlock();
+        bool ok = job.file->writeOut(job.data, job.n);
+        guard.lock();
+
+        n_bytes = n_bytes + job.n;
+        failed = failed || !ok;
+        first = (first + 1) % jobs.size();
+        n_jobs--;
+        job.file->in_flight--;
+        done.notify_all();
+    }
+}
+
+long long OutputWriter::getNumBytes() {
+    std::lock_guard<std::mutex> guard(lock);
+    return n_bytes;
+}
+
+double OutputWriter::getBlockedTime() {
+    std::lock_guard<std::mutex> guard(lock);
+    return blocked_time.count();
+}
+
+bool OutputWriter::hasFailed() {
+    std::lock_guard<std::mutex> guard(lock);
+    return failed;
+}
+
+/////////////// FILES ////////////////
+
+OutputFile::~OutputFile() { close(); }
+
+void OutputFile::setWriter(OutputWriter *w) { writer = w; }
+
+bool OutputFile::open(std::string path, bool append) {
+    close();
+    int flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+    fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size = append ? (long long)lseek(fd, 0, SEEK_END) : 0;
+
+    std::size_t n = writer ? writer->getBufferSize() : 64 * 1024;
+    buffers[0].resize(n);
+    buffers[1].resize(n);
+    current = 0;
+    used = 0;
+    if (writer) {
+        writer->attach();
+    }
+    return true;
+}
+
+bool OutputFile::isOpen() { return fd >= 0; }
+
+void OutputFile::close() {
+    if (fd < 0) {
+        return;
+    }
+    flush();
+    ::close(fd);
+    fd = -1;
+    if (writer) {
+        writer->detach();
+    }
+}
+
+void OutputFile::flush() {
+    if (fd < 0) {
+        return;
+    }
+    if (used > 0) {
+        swapBuffers();
+    }
+    if (writer) {
+        writer->waitFor(this, 0);
+    }
+}
+
+long long OutputFile::getSize() { return fd < 0 ? -1 : size; }
+
+bool OutputFile::writeOut(const char *data, std::size_t n) {
+    std::size_t done = 0;
+    while (done < n) {
+        ssize_t written = ::write(fd, data + done, n - done);
+        if (written <= 0) {
+            return false;
+        }
+        done = done + written;
+    }
+    return true;
+}
+
+void OutputFile::swapBuffers() {
+    if (writer == nullptr) {
+        writeOut(buffers[current].data(), used);
+        used = 0;
+        return;
+    }
+    writer->submit(this, buffers[current].data(), used);
+    current = 1 - current;
+    used = 0;
+    writer->waitFor(this, 1); // the one just handed over
+}
+
+OutputFile &OutputFile::operator<<(double value) {
+    if (fd < 0) {
+        return *this;
+    }
+    if (buffers[current].size() - used < 16) {
+        swapBuffers();
+    }
+    int n = formatNumber(buffers[current].data() + used, value);
+    used = used + n;
+    size = size + n;
+    return *this;
+}
+
+OutputFile &OutputFile::operator<<(const char *text) {
+    if (fd < 0) {
+        return *this;
+    }
+    for (const char *c = text; *c != '\0'; c++) {
+        if (used == buffers[current].size()) {
+            swapBuffers();
+        }
+        buffers[current][used++] = *c;
+        size++;
+    }
+    return *this;
+}
+
+/////////////// NUMBERS ////////////////
+
+// 10^k for k = 0..25, all of them exact in a long double
+struct PowersOfTen {
+    long double p[26];
+    PowersOfTen() {
+        p[0] = 1;
+        for (int k = 1; k < 26; k++) {
+            p[k] = p[k - 1] * 10;
+        }
+    }
+};
+
+// value * 10^k with a single rounding
+static long double scaled(double value, int k) {
+    static const PowersOfTen powers;
+    return k >= 0 ? value * powers.p[k] : value / powers.p[-k];
+}
+
+int formatNumber(char *out, double value) {
+    // six significant digits of a value between 1e-19 and 1e19, unless it
+    // is so close to halfway between two of them that the rounding of the
+    // scaling could decide which. those, zero, infinities and nans go
+    // through printf
+    double mag = std::fabs(value);
+    int e = mag > 0 ? int(std::floor(std::log10(mag))) : 0;
+    if (!(mag >= 1e-19 && mag < 1e19)) {
+        return std::snprintf(out, 16, "%g", value);
+    }
+    long double s = scaled(mag, 5 - e);
+    if (s >= 999999.5L) {
+        e++;
+        s = scaled(mag, 5 - e);
+    } else if (s < 99999.5L) {
+        e--;
+        s = scaled(mag, 5 - e);
+    }
+    long double frac = s - std::floor(s);
+    if (s < 99999.5L || s >= 999999.5L || std::fabs(frac - 0.5L) < 1e-6L) {
+        return std::snprintf(out, 16, "%g", value);
+    }
+
+    long m = long(s + 0.5L);
+    char digits[6];
+    for (int d = 5; d >= 0; d--) {
+        digits[d] = char('0' + m % 10);
+        m = m / 10;
+    }
+    int n_digits = 6; // without the trailing zeros
+    while (n_digits > 1 && digits[n_digits - 1] == '0') {
+        n_digits--;
+    }
+
+    int n = 0;
+    if (value < 0) {
+        out[n++] = '-';
+    }
+    if (e < -4 || e >= 6) {
+        out[n++] = digits[0];
+        if (n_digits > 1) {
+            out[n++] = '.';
+            for (int d = 1; d < n_digits; d++) {
+                out[n++] = digits[d];
+            }
+        }
+        out[n++] = 'e';
+        out[n++] = e < 0 ? '-' : '+';
+        int x = e < 0 ? -e : e;
+        out[n++] = char('0' + x / 10);
+        out[n++] = char('0' + x % 10);
+    } else if (e >= 0) {
+        for (int d = 0; d <= e; d++) {
+            out[n++] = digits[d];
+        }
+        if (n_digits > e + 1) {
+            out[n++] = '.';
+            for (int d = e + 1; d < n_digits; d++) {
+                out[n++] = digits[d];
+            }
+        }
+    } else {
+        out[n++] = '0';
+        out[n++] = '.';
+        for (int z = 0; z < -e - 1; z++) {
+            out[n++] = '0';
+        }
+        for (int d = 0; d < n_digits; d++) {
+            out[n++] = digits[d];
+        }
+    }
+    return n;
+}
@@ -0,0 +1,113 @@
+#ifndef OUTPUTWRITER_H
+#define OUTPUTWRITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Parameters.h"
+
+/* BUFFERED OUTPUT OF THE SAMPLES
+ * THE TEXT FILES THAT GROW WITH EVERY SAMPLE (THE POSITIONS, THE ENERGIES OF
+ * THE PARTICLES, THE VIRIAL AND ENERGY SERIES, THE FORCES) ARE OutputFiles.
+ * A NUMBER IS FORMATTED STRAIGHT INTO A PREALLOCATED BUFFER OF THE FILE,
+ * EXACTLY AS AN ofstream PRINTS IT, AND A FULL BUFFER IS HANDED TO THE
+ * WRITER THREAD OF THE SIMULATION WHILE THE SAMPLING FILLS THE OTHER ONE OF
+ * THE PAIR. THE SAMPLING ONLY WAITS IF THAT ONE IS STILL BEING WRITTEN. A
+ * FILE WITHOUT A WRITER WRITES ITS BUFFERS ITSELF
+ */
+class OutputFile;
+
+class OutputWriter {
+
+  private:
+    struct Job {
+        OutputFile *file;
+        const char *data;
+        std::size_t n;
+    };
+    std::vector<Job> jobs; // a ring, two per file at most
+    std::size_t first = 0;
+    std::size_t n_jobs = 0;
+    std::size_t buffer_size = 256 * 1024;
+
+    std::mutex lock;
+    std::condition_variable wake; // the writer, for a job or to stop
+    std::condition_variable done; // the files, for a job written
+    std::thread thread;
+    bool stop = false;
+    int n_files = 0; // open on this writer
+
+    long long n_bytes = 0;
+    std::chrono::duration<double> blocked_time{0};
+    bool failed = false;
+
+    void work();
+    friend class OutputFile;
+    void attach();
+    void detach();
+    void submit(OutputFile *file, const char *data, std::size_t n);
+    // until the file has at most n buffers queued or being written
+    void waitFor(OutputFile *file, int n);
+
+  public:
+    OutputWriter() = default;
+    OutputWriter(const OutputWriter &) = delete;
+    OutputWriter &operator=(const OutputWriter &) = delete;
+    ~OutputWriter();
+
+    // the size of the buffers, output_buffer kilobytes
+    void initializeOutputWriter(Parameters *p);
+    std::size_t getBufferSize();
+
+    long long getNumBytes();
+    double getBlockedTime(); // seconds the sampling waited for the writer
+    bool hasFailed();        // a write went wrong
+};
+
+class OutputFile {
+
+  private:
+    OutputWriter *writer = nullptr;
+    int fd = -1;
+    std::vector<char> buffers[2];
+    int current = 0;
+    std::size_t used = 0;
+    int in_flight = 0; // buffers with the writer, under its lock
+    long long size = 0; // the bytes put into the file so far
+
+    // hands the current buffer over and fills the other one
+    void swapBuffers();
+    bool writeOut(const char *data, std::size_t n);
+    friend class OutputWriter;
+
+  public:
+    OutputFile() = default;
+    OutputFile(const OutputFile &) = delete;
+    OutputFile &operator=(const OutputFile &) = delete;
+    ~OutputFile();
+
+    // set before the file is opened, nullptr writes on the calling thread
+    void setWriter(OutputWriter *w);
+
+    // empties the file, or goes on at its end with append
+    bool open(std::string path, bool append = false);
+    bool isOpen();
+    void close();
+    // the bytes put so far are in the file
+    void flush();
+    long long getSize();
+
+    // double as an ofstream prints it with the default precision
+    OutputFile &operator<<(double value);
+    OutputFile &operator<<(const char *text);
+};
+
+// the characters of value as printf("%g") writes them (at most 16), in a
+// few multiplications instead of a full conversion
+int formatNumber(char *out, double value);
+#endif
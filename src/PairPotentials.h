@@ -0,0 +1,106 @@
+#ifndef PAIRPOTENTIALS_H
+#define PAIRPOTENTIALS_H
+
+#include <cmath>
+
+#include "Potential.h"
+
+/* PAIR POTENTIAL POLICIES
+ * EACH POLICY EVALUATES ONE PAIR FROM ITS SQUARED CHARACTERISTIC DISTANCE
+ * r2 = (r/sigma)^2 AND ITS KIND (0 = PARALLEL, 1 = ANTIPARALLEL). THE PAIR
+ * LOOPS IN INTERACTION AND PROPERTIES ARE TEMPLATES OVER THESE POLICIES,
+ * INSTANTIATED ONCE PER POLICY AND CHOSEN ONCE FROM THE interactionType, SO
+ * THE INNERMOST LOOPS NEVER BRANCH ON THE TYPE OF INTERACTION. THE FORCE IS
+ * THE MAGNITUDE -dU/dr OF THE Potential CLASS AND ALSO TAKES r = sqrt(r2)
+ */
+struct PairParams {
+    double affinity[2] = {0, 0}; // a_ref and a_ref * a_mult
+    double trunc_shift = 0;
+    double inv_sigma = 0;
+    double wca_cut2 = 0;
+    double rest_L = 0;
+    double k_spring = 0;
+    double red_temp = 0;
+    PotentialTable *table = nullptr;
+
+    void initializePairParams(Parameters *p, Potential *pot,
+                              PotentialTable *tab) {
+        affinity[0] = p->getRefAffinity();
+        affinity[1] = p->getRefAffinity() * p->getAffinityMult();
+        trunc_shift = pot->getTruncShift();
+        inv_sigma = 1 / p->getSigma();
+        wca_cut2 = pot->getWCA_Cut() * pot->getWCA_Cut();
+        rest_L = p->getRestLength();
+        k_spring = p->getSprConst();
+        red_temp = p->getRedTemp();
+        table = tab;
+    }
+};
+
+// interactionType 0: the overlap test lives in Interaction::hardDisks
+struct HardDiskPair {
+    static double energy(const PairParams &p, double r2, int kind) {
+        return 0;
+    }
+    static double force(const PairParams &p, double r2, double r, int kind) {
+        return 0;
+    }
+};
+
+// interactionType 1
+struct LennardJonesPair {
+    static double energy(const PairParams &p, double r2, int kind) {
+        double ir6 = 1 / (r2 * r2 * r2);
+        return 4 * p.affinity[kind] * (ir6 * ir6 - ir6 + p.trunc_shift);
+    }
+    static double force(const PairParams &p, double r2, double r, int kind) {
+        double ir6 = 1 / (r2 * r2 * r2);
+        return 24 * p.affinity[kind] * p.inv_sigma * (2 * ir6 * ir6 - ir6) / r;
+    }
+};
+
+// interactionType 2: independent of the binding affinity
+struct WCAPair {
+    static double energy(const PairParams &p, double r2, int kind) {
+        if (r2 > p.wca_cut2) {
+            return 0;
+        }
+        double ir6 = 1 / (r2 * r2 * r2);
+        return 4 * (ir6 * ir6 - ir6 + .25);
+    }
+    static double force(const PairParams &p, double r2, double r, int kind) {
+        if (r2 > p.wca_cut2) {
+            return 0;
+        }
+        double ir6 = 1 / (r2 * r2 * r2);
+        return 24 * p.inv_sigma * (2 * ir6 * ir6 - ir6) / r;
+    }
+};
+
+// interactionType 3
+struct WCASpringPair {
+    static double energy(const PairParams &p, double r2, int kind) {
+        double u = sqrt(r2) - p.rest_L;
+        double ku2 = p.k_spring * u * u;
+        return WCAPair::energy(p, r2, kind) +
+               p.affinity[kind] * .5 * p.red_temp * ku2 * exp(-.5 * ku2);
+    }
+    static double force(const PairParams &p, double r2, double r, int kind) {
+        double u = r - p.rest_L;
+        double ku2 = p.k_spring * u * u;
+        return WCAPair::force(p, r2, r, kind) +
+               p.affinity[kind] * p.red_temp * p.k_spring * u *
+                   exp(-.5 * ku2) * (.5 * ku2 - 1);
+    }
+};
+
+// any of the above through the PotentialTable
+struct TabulatedPair {
+    static double energy(const PairParams &p, double r2, int kind) {
+        return p.table->energy(r2, kind);
+    }
+    static double force(const PairParams &p, double r2, double r, int kind) {
+        return p.table->force(r2, kind);
+    }
+};
+#endif
@@ -23,6 +23,77 @@ void Parameters::initializeParameters(std::string yamlFile) {
 
     ext_well_d = node["external_well_depth"].as<double>();
 
+    // optional keys keep older parameter files usable
+    if (node["verlet_skin"]) {
+        verlet_skin = node["verlet_skin"].as<double>();
+    }
+    if (node["potential_table_size"]) {
+        table_size = node["potential_table_size"].as<int>();
+    }
+    if (node["delta_kernel"]) {
+        delta_kernel = node["delta_kernel"].as<int>();
+    }
+    if (node["track_energy"]) {
+        track_energy = node["track_energy"].as<int>() != 0;
+    }
+    if (node["per_particle_energy"]) {
+        per_particle_energy = node["per_particle_energy"].as<int>() != 0;
+    }
+    if (node["energy_check_interval"]) {
+        energy_check = node["energy_check_interval"].as<int>();
+    }
+    if (node["event_chain"]) {
+        event_chain = node["event_chain"].as<int>() != 0;
+    }
+    if (node["chain_length"]) {
+        chain_length = node["chain_length"].as<double>();
+    }
+    if (node["cluster_move_ratio"]) {
+        cluster_ratio = node["cluster_move_ratio"].as<double>();
+    }
+    if (node["replica_temps"]) {
+        replica_temps = node["replica_temps"].as<std::vector<double>>();
+    }
+    if (node["swap_interval"]) {
+        swap_interval = node["swap_interval"].as<int>();
+    }
+    if (node["rng_type"]) {
+        rng_type = node["rng_type"].as<int>();
+    }
+    if (node["spring_cutoff"]) {
+        spring_cut = node["spring_cutoff"].as<double>();
+    }
+    if (node["sweep_threads"]) {
+        sweep_threads = node["sweep_threads"].as<int>();
+    }
+    if (node["sample_threads"]) {
+        sample_threads = node["sample_threads"].as<int>();
+    }
+    if (node["analysis_buffer"]) {
+        analysis_buffer = node["analysis_buffer"].as<int>();
+    }
+    if (node["trajectory_format"]) {
+        trajectory_format = node["trajectory_format"].as<int>();
+    }
+    if (node["checkpoint_interval"]) {
+        checkpoint_interval = node["checkpoint_interval"].as<int>();
+    }
+    if (node["config_cache"]) {
+        config_cache = node["config_cache"].as<std::string>();
+    }
+    if (node["warm_start_sweeps"]) {
+        warm_start_sweeps = node["warm_start_sweeps"].as<int>();
+    }
+    if (node["output_buffer"]) {
+        output_buffer = node["output_buffer"].as<int>();
+    }
+    if (node["ensemble_chains"]) {
+        ensemble_chains = node["ensemble_chains"].as<int>();
+    }
+    if (node["num_threads"]) {
+        num_threads = node["num_threads"].as<int>();
+    }
+
     // add a check such that a bunch of zeros can't be added
     if (boxLength == 0) {
         boxLength = sigma * sqrt(n_particles / redDensity);
@@ -39,6 +110,8 @@ void Parameters::initializeParameters(std::string yamlFile) {
 
     seed = node["seed"].as<long>();
     n_updates = node["numberUpdates"].as<int>();
+    n_type1 = node["type1_Particles"].as<int>();
+    radius = node["particleRadius"].as<double>();
 
     init_type = node["initializationType"].as<int>();
     interact_type = node["interactionType"].as<int>();
@@ -56,8 +129,109 @@ long Parameters::getSeed() { return seed; }
 int Parameters::getInit_Type() { return init_type; }
 int Parameters::getInteract_Type() { return interact_type; }
 int Parameters::getBound_Type() { return bound_type; }
+int Parameters::getRngType() { return rng_type; }
 
 double Parameters::getExtWellDepth() { return ext_well_d; }
+double Parameters::getVerletSkin() { return verlet_skin; }
+int Parameters::getTableSize() { return table_size; }
+int Parameters::getDeltaKernel() { return delta_kernel; }
+bool Parameters::getTrackEnergy() { return track_energy; }
+bool Parameters::getPerParticleEnergy() { return per_particle_energy; }
+int Parameters::getEnergyCheck() { return energy_check; }
+bool Parameters::getEventChain() { return event_chain; }
+double Parameters::getChainLength() { return chain_length; }
+double Parameters::getClusterRatio() { return cluster_ratio; }
+std::vector<double> Parameters::getReplicaTemps() { return replica_temps; }
+int Parameters::getSwapInterval() { return swap_interval; }
+int Parameters::getSweepThreads() { return sweep_threads; }
+int Parameters::getSampleThreads() { return sample_threads; }
+int Parameters::getAnalysisBuffer() { return analysis_buffer; }
+int Parameters::getTrajectoryFormat() { return trajectory_format; }
+int Parameters::getCheckpointInterval() { return checkpoint_interval; }
+std::string Parameters::getConfigCache() { return config_cache; }
+int Parameters::getWarmStartSweeps() { return warm_start_sweeps; }
+int Parameters::getOutputBuffer() { return output_buffer; }
+int Parameters::getEnsembleChains() { return ensemble_chains; }
+int Parameters::getNumThreads() { return num_threads; }
+
+int Parameters::getStream() { return stream; }
+std::string Parameters::getOutputPrefix() { return output_prefix; }
+
+// a seed for each stream, mixed from the yaml seed (splitmix64) so that
+// neighbouring streams start far apart
+long Parameters::getStreamSeed() {
+    unsigned long long z =
+        (unsigned long long)seed + 0x9E3779B97F4A7C15ULL * stream;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return long(z ^ (z >> 31));
+}
+
+// FNV-1a over the bytes of one value
+static void hashBytes(unsigned long long *h, const void *value, int n) {
+    const unsigned char *bytes = (const unsigned char *)value;
+    for (int i = 0; i < n; i++) {
+        *h = (*h ^ bytes[i]) * 0x100000001B3ULL;
+    }
+}
+
+unsigned long long Parameters::getPhysicsHash() {
+    unsigned long long h = 0xCBF29CE484222325ULL;
+    int ints[4] = {n_particles, n_type1, interact_type, bound_type};
+    double doubles[11] = {redDensity, redTemp, sigma,    boxLength,
+                          radius,     a_ref,   a_mult,   k_spring,
+                          rest_L,     spring_cut,        ext_well_d};
+    hashBytes(&h, ints, sizeof(ints));
+    hashBytes(&h, doubles, sizeof(doubles));
+    // a tabulated potential is a (slightly) different potential
+    hashBytes(&h, &table_size, sizeof(table_size));
+    return h;
+}
+
+// what is left of the physics hash once the box follows from the density
+unsigned long long Parameters::getSystemHash() {
+    unsigned long long h = 0xCBF29CE484222325ULL;
+    int ints[4] = {n_particles, n_type1, interact_type, bound_type};
+    double doubles[8] = {sigma,    radius, a_ref,      a_mult,
+                         k_spring, rest_L, spring_cut, ext_well_d};
+    hashBytes(&h, ints, sizeof(ints));
+    hashBytes(&h, doubles, sizeof(doubles));
+    hashBytes(&h, &table_size, sizeof(table_size));
+    return h;
+}
+
+// the moves and neighbour structures change what is saved, the number of
+// sweeps does not, so a finished run can be extended
+unsigned long long Parameters::getRunHash() {
+    unsigned long long h = getPhysicsHash();
+    int ints[10] = {init_type,          rng_type,
+                    stream,             delta_kernel,
+                    energy_check,       sweep_threads,
+                    trajectory_format,  int(track_energy),
+                    int(event_chain),   int(per_particle_energy)};
+    double doubles[3] = {verlet_skin, chain_length, cluster_ratio};
+    hashBytes(&h, &seed, sizeof(seed));
+    hashBytes(&h, ints, sizeof(ints));
+    hashBytes(&h, doubles, sizeof(doubles));
+    return h;
+}
+
+void Parameters::setRedTemp(double t) { redTemp = t; }
+void Parameters::setSweepThreads(int n) { sweep_threads = n; }
+void Parameters::setSampleThreads(int n) { sample_threads = n; }
+void Parameters::setDeltaKernel(int k) { delta_kernel = k; }
+void Parameters::setTableSize(int n) { table_size = n; }
+void Parameters::setRngType(int t) { rng_type = t; }
+void Parameters::setReplicaTemps(std::vector<double> t) { replica_temps = t; }
+void Parameters::setAnalysisBuffer(int n) { analysis_buffer = n; }
+void Parameters::setTrajectoryFormat(int f) { trajectory_format = f; }
+void Parameters::setCheckpointInterval(int n) { checkpoint_interval = n; }
+void Parameters::setConfigCache(std::string dir) { config_cache = dir; }
+void Parameters::setWarmStartSweeps(int n) { warm_start_sweeps = n; }
+void Parameters::setOutputBuffer(int kb) { output_buffer = kb; }
+void Parameters::setEnsembleChains(int n) { ensemble_chains = n; }
+void Parameters::setStream(int s) { stream = s; }
+void Parameters::setOutputPrefix(std::string prefix) { output_prefix = prefix; }
 
 double Parameters::getRefAffinity() { return a_ref; }
 double Parameters::getAffinityMult() { return a_mult; };
@@ -68,4 +242,5 @@ double Parameters::getRedTemp() { return redTemp; }
 double Parameters::getBoxLength() { return boxLength; }
 
 double Parameters::getRestLength() { return rest_L; }
+double Parameters::getSpringCutoff() { return spring_cut; }
 double Parameters::getSprConst() { return k_spring; }
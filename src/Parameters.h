@@ -2,6 +2,8 @@
 #define PARAMETERS_H
 
 #include <cmath>
+#include <string>
+#include <vector>
 #include <yaml-cpp/yaml.h>
 
 class Parameters {
@@ -14,6 +16,7 @@ class Parameters {
     double boxLength = 0;
     double rest_L = 0;
     double k_spring = 0;
+    double spring_cut = 0; // in units of sigma, 0 = half the box
 
     double a_ref = 0;
     double a_mult = 0;
@@ -23,13 +26,45 @@ class Parameters {
 
     int n_updates = 0;
     int n_particles = 0;
+    int n_type1 = 0;
+    double radius = 0;
     long seed = 0;
 
     double ext_well_d = 0;
+    double verlet_skin = 0; // 0 turns the verlet lists off
+    int table_size = 0;     // 0 evaluates the potentials analytically
+    int delta_kernel = 0;   // 0 = pair loops, 1 = scalar, 2 = AVX2, 3 = AVX-512
+
+    bool track_energy = false; // running total energy from accepted moves
+    bool per_particle_energy = false;
+    int energy_check = 0; // sweeps between full recomputes, 0 = never
+
+    bool event_chain = false; // event chains instead of single hard disk moves
+    double chain_length = 0;  // in units of sigma, 0 = a quarter of the box
+    double cluster_ratio = 0; // fraction of the moves that are cluster moves
+
+    int sweep_threads = 0; // checkerboard sweep on this many threads, 0 = off
+    int sample_threads = 0; // property sampling on this many, 0 = serial
+    int analysis_buffer = 0; // samples analysed on their own thread if > 0
+    int trajectory_format = 0; // 0 = positions.txt, 1 = float64, 2 = float32
+    int checkpoint_interval = 0; // sweeps between checkpoints, 0 = none
+    std::string config_cache;    // equilibrated configurations, "" = none
+    int warm_start_sweeps = 0;   // re-equilibration after a warm start
+    int output_buffer = 0; // kilobytes per buffer of a sample file, 0 = 256
+
+    std::vector<double> replica_temps; // replica exchange if 2 or more
+    int swap_interval = 0;             // sweeps between swap attempts
+    int ensemble_chains = 0;           // independent chains if 2 or more
+    int num_threads = 0;               // 0 = one per core
+
+    // set by the drivers that run several simulations from one file
+    int stream = 0; // 0 = the yaml seed itself
+    std::string output_prefix;
 
     int init_type = 0;
     int interact_type = 0;
     int bound_type = 0;
+    int rng_type = 0; // 0 = JKISS, 1 = Philox
 
   public:
     // may be worth adding a default constructor that reads in the yaml file
@@ -42,6 +77,7 @@ class Parameters {
     int getInit_Type();
     int getInteract_Type();
     int getBound_Type();
+    int getRngType();
 
     int getEq_sweep();
     int getData_interval();
@@ -50,9 +86,44 @@ class Parameters {
     double getAffinityMult();
 
     double getExtWellDepth();
+    double getVerletSkin();
+    int getTableSize();
+    int getDeltaKernel();
+    bool getTrackEnergy();
+    bool getPerParticleEnergy();
+    int getEnergyCheck();
+    bool getEventChain();
+    double getChainLength();
+    double getClusterRatio();
+    int getSweepThreads();
+    int getSampleThreads();
+    int getAnalysisBuffer();
+    int getTrajectoryFormat();
+    int getCheckpointInterval();
+    std::string getConfigCache();
+    int getWarmStartSweeps();
+    int getOutputBuffer();
+    std::vector<double> getReplicaTemps();
+    int getSwapInterval();
+    int getEnsembleChains();
+    int getNumThreads();
+
+    int getStream();
+    long getStreamSeed();
+    std::string getOutputPrefix();
+
+    // identifies the physical system: the particles, the state point and the
+    // interactions, but not the seed or how the run is carried out
+    unsigned long long getPhysicsHash();
+    // the physical system without its state point (density and temperature)
+    unsigned long long getSystemHash();
+    // identifies a run: the physical system, the seed and everything that
+    // decides the state a checkpoint holds
+    unsigned long long getRunHash();
 
     double getSprConst();
     double getRestLength();
+    double getSpringCutoff();
     double getRedDens();
     double getRedTemp();
     double getSigma();
@@ -60,6 +131,23 @@ class Parameters {
 
     // NOTE: THE SETTERS ARE NOT NECESSARY
     // GIVEN THAT THESE PARAMETERS ARE CONSTANT
-    // THROUGHOUT THE SIMULATION
+    // THROUGHOUT THE SIMULATION. THE ONES BELOW ARE FOR THE DRIVERS THAT
+    // RUN SEVERAL SIMULATIONS FROM ONE FILE (AND FOR THE TESTS)
+    void setRedTemp(double t);
+    void setSweepThreads(int n);
+    void setSampleThreads(int n);
+    void setDeltaKernel(int k);
+    void setTableSize(int n);
+    void setRngType(int t);
+    void setReplicaTemps(std::vector<double> t);
+    void setAnalysisBuffer(int n);
+    void setTrajectoryFormat(int f);
+    void setCheckpointInterval(int n);
+    void setConfigCache(std::string dir);
+    void setWarmStartSweeps(int n);
+    void setOutputBuffer(int kb);
+    void setEnsembleChains(int n);
+    void setStream(int s);
+    void setOutputPrefix(std::string prefix);
 };
 #endif
@@ -0,0 +1,58 @@
+#include "ParticleStore.h"
+
+// every array holds one entry per particle, all zero until they are set
+void ParticleStore::resize(int n) {
+    n_particles = n;
+
+    type.resize(n, 0);
+    radius.resize(n, 0);
+    x_position.resize(n, 0);
+    y_position.resize(n, 0);
+    x_trialPos.resize(n, 0);
+    y_trialPos.resize(n, 0);
+    stepWeight.resize(n, 0);
+    x_force.resize(n, 0);
+    y_force.resize(n, 0);
+}
+
+////////// OBJECT FUNCTIONS ////////////////
+
+double ParticleStore::x_trial(int k, double randVal) const {
+    return x_position[k] + stepWeight[k] * (randVal - 0.5);
+}
+double ParticleStore::y_trial(int k, double randVal) const {
+    return y_position[k] + stepWeight[k] * (randVal - 0.5);
+}
+
+void ParticleStore::acceptTrial(int k) {
+    x_position[k] = x_trialPos[k];
+    y_position[k] = y_trialPos[k];
+}
+
+void ParticleStore::resetForce(int k) {
+    x_force[k] = 0;
+    y_force[k] = 0;
+}
+void ParticleStore::addForce(int k, double fx, double fy) {
+    x_force[k] += fx;
+    y_force[k] += fy;
+}
+
+void ParticleStore::swapPositions(ParticleStore *other) {
+    x_position.swap(other->x_position);
+    y_position.swap(other->y_position);
+    x_trialPos.swap(other->x_trialPos);
+    y_trialPos.swap(other->y_trialPos);
+}
+
+void ParticleStore::saveState(CheckpointWriter *out) {
+    out->putVector(type);
+    out->putVector(x_position);
+    out->putVector(y_position);
+}
+
+void ParticleStore::loadState(CheckpointReader *in) {
+    in->getVector(&type);
+    in->getVector(&x_position);
+    in->getVector(&y_position);
+}
@@ -0,0 +1,83 @@
+#ifndef PARTICLESTORE_H
+#define PARTICLESTORE_H
+
+#include <vector>
+
+#include "Checkpoint.h"
+
+/* STRUCTURE OF ARRAYS PARTICLE STORE
+ * EVERY PROPERTY OF THE PARTICLES IS KEPT IN ITS OWN CONTIGUOUS ARRAY AND A
+ * PARTICLE IS ONLY ITS INDEX, WHICH ALSO SERVES AS ITS IDENTIFIER. THE PAIR
+ * LOOPS THEREFORE STREAM THROUGH THE POSITION AND TYPE ARRAYS INSTEAD OF
+ * COPYING WHOLE PARTICLE OBJECTS, AND NO PARTICLE OWNS ANY HEAP MEMORY
+ */
+class ParticleStore {
+
+  private:
+    int n_particles = 0;
+
+    std::vector<int> type; // may be worth changing type to a string later on
+
+    std::vector<double> radius;
+    std::vector<double> x_position;
+    std::vector<double> y_position;
+
+    std::vector<double> x_trialPos;
+    std::vector<double> y_trialPos;
+
+    std::vector<double> stepWeight;
+
+    std::vector<double> x_force;
+    std::vector<double> y_force;
+
+  public:
+    void resize(int n);
+    int size() const { return n_particles; }
+
+    // the accessors are defined here so they inline into the pair loops
+
+    // GETTERS //
+    int getType(int k) const { return type[k]; }
+
+    double getRadius(int k) const { return radius[k]; }
+    double getX_Position(int k) const { return x_position[k]; }
+    double getY_Position(int k) const { return y_position[k]; }
+    double getX_TrialPos(int k) const { return x_trialPos[k]; }
+    double getY_TrialPos(int k) const { return y_trialPos[k]; }
+    double getStepWeight(int k) const { return stepWeight[k]; }
+
+    double getX_Force(int k) const { return x_force[k]; }
+    double getY_Force(int k) const { return y_force[k]; }
+
+    // whole arrays, for loops over all of the particles
+    const int *getTypes() const { return type.data(); }
+    const double *getX_Positions() const { return x_position.data(); }
+    const double *getY_Positions() const { return y_position.data(); }
+
+    // SETTERS //
+    void setType(int k, int t) { type[k] = t; }
+
+    void setRadius(int k, double rad) { radius[k] = rad; }
+    void setX_Position(int k, double x) { x_position[k] = x; }
+    void setY_Position(int k, double y) { y_position[k] = y; }
+    void setX_TrialPos(int k, double x) { x_trialPos[k] = x; }
+    void setY_TrialPos(int k, double y) { y_trialPos[k] = y; }
+    void setStepWeight(int k, double w) { stepWeight[k] = w; }
+
+    void addForce(int k, double fx, double fy);
+    void resetForce(int k);
+
+    // moves the trial position to the current one
+    void acceptTrial(int k);
+
+    // exchanges the positions with another store of the same particles
+    void swapPositions(ParticleStore *other);
+
+    double x_trial(int k, double randVal) const;
+    double y_trial(int k, double randVal) const;
+
+    // the positions and types, the rest follows from the parameters
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+};
+#endif
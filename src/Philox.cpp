@@ -0,0 +1,165 @@
+#include "Philox.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// the two 53 bit doubles of one block, built the way KISSRNG builds them
+static inline void blockDoubles(const unsigned int w[4], double *out) {
+    out[0] = ((w[0] >> 6) * 134217728.0 + (w[1] >> 5)) / 9007199254740992.0;
+    out[1] = ((w[2] >> 6) * 134217728.0 + (w[3] >> 5)) / 9007199254740992.0;
+}
+
+void PhiloxRNG::Block(unsigned long long counter, unsigned int out[4]) {
+    const unsigned int m0 = 0xD2511F53u;
+    const unsigned int m1 = 0xCD9E8D57u;
+    const unsigned int w0 = 0x9E3779B9u; // the key schedule (golden ratio
+    const unsigned int w1 = 0xBB67AE85u; // and sqrt(3) - 1)
+
+    unsigned int c0 = (unsigned int)counter;
+    unsigned int c1 = (unsigned int)(counter >> 32);
+    unsigned int c2 = (unsigned int)stream;
+    unsigned int c3 = (unsigned int)(stream >> 32);
+    unsigned int k0 = key[0];
+    unsigned int k1 = key[1];
+
+    for (int round = 0; round < 10; round++) {
+        unsigned long long p0 = (unsigned long long)m0 * c0;
+        unsigned long long p1 = (unsigned long long)m1 * c2;
+        unsigned int hi0 = (unsigned int)(p0 >> 32);
+        unsigned int hi1 = (unsigned int)(p1 >> 32);
+
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = (unsigned int)p1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = (unsigned int)p0;
+
+        k0 = k0 + w0;
+        k1 = k1 + w1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+void PhiloxRNG::Init(unsigned long long seed, unsigned long long stream_id) {
+    key[0] = (unsigned int)seed;
+    key[1] = (unsigned int)(seed >> 32);
+    stream = stream_id;
+    position = 0;
+}
+
+void PhiloxRNG::InitCold(long seed) { Init(seed, 0); }
+
+double PhiloxRNG::RandomUniformDbl() {
+    if (position % 2 == 0) {
+        unsigned int w[4];
+        Block(position / 2, w);
+        blockDoubles(w, pair);
+    }
+    return pair[position++ % 2];
+}
+
+#if defined(__SSE2__)
+// four blocks side by side, one in each 32 bit lane. SSE2 multiplies the even
+// lanes only, so the odd lanes are shifted down and multiplied apart
+static inline void mulhilo(__m128i a, __m128i m, __m128i *hi, __m128i *lo) {
+    const __m128i low = _mm_set1_epi64x(0xFFFFFFFFLL);
+    __m128i even = _mm_mul_epu32(a, m);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+    *hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(low, odd));
+    *lo = _mm_or_si128(_mm_and_si128(even, low), _mm_slli_epi64(odd, 32));
+}
+#endif
+
+// lanes consecutive blocks at once, with the same words as Block gives one at
+// a time. Four groups of four are in flight so the multiplies overlap
+void PhiloxRNG::Blocks(unsigned long long counter, double *out) {
+    unsigned int w[4][lanes];
+    for (int l = 0; l < lanes; l++) {
+        w[0][l] = (unsigned int)(counter + l);
+        w[1][l] = (unsigned int)((counter + l) >> 32);
+        w[2][l] = (unsigned int)stream;
+        w[3][l] = (unsigned int)(stream >> 32);
+    }
+
+#if defined(__SSE2__)
+    const __m128i m0 = _mm_set1_epi32(0xD2511F53);
+    const __m128i m1 = _mm_set1_epi32(0xCD9E8D57);
+    __m128i c[lanes / 4][4];
+    for (int g = 0; g < lanes / 4; g++) {
+        for (int j = 0; j < 4; j++) {
+            c[g][j] = _mm_loadu_si128((__m128i *)(w[j] + 4 * g));
+        }
+    }
+    unsigned int k0 = key[0];
+    unsigned int k1 = key[1];
+
+    for (int round = 0; round < 10; round++) {
+        __m128i key0 = _mm_set1_epi32(k0);
+        __m128i key1 = _mm_set1_epi32(k1);
+        for (int g = 0; g < lanes / 4; g++) {
+            __m128i hi0, lo0, hi1, lo1;
+            mulhilo(c[g][0], m0, &hi0, &lo0);
+            mulhilo(c[g][2], m1, &hi1, &lo1);
+            c[g][0] = _mm_xor_si128(_mm_xor_si128(hi1, c[g][1]), key0);
+            c[g][2] = _mm_xor_si128(_mm_xor_si128(hi0, c[g][3]), key1);
+            c[g][1] = lo1;
+            c[g][3] = lo0;
+        }
+        k0 = k0 + 0x9E3779B9u;
+        k1 = k1 + 0xBB67AE85u;
+    }
+    for (int g = 0; g < lanes / 4; g++) {
+        for (int j = 0; j < 4; j++) {
+            _mm_storeu_si128((__m128i *)(w[j] + 4 * g), c[g][j]);
+        }
+    }
+#else
+    for (int l = 0; l < lanes; l++) {
+        unsigned int b[4];
+        Block(counter + l, b);
+        for (int j = 0; j < 4; j++) {
+            w[j][l] = b[j];
+        }
+    }
+#endif
+
+    for (int l = 0; l < lanes; l++) {
+        unsigned int b[4] = {w[0][l], w[1][l], w[2][l], w[3][l]};
+        blockDoubles(b, out + 2 * l);
+    }
+}
+
+// whole blocks straight into out, with no copy through pair
+void PhiloxRNG::FillUniformDbl(double *out, int n) {
+    int i = 0;
+    if (position % 2 == 1 && n > 0) {
+        out[i++] = RandomUniformDbl();
+    }
+    for (; i + 2 * lanes <= n; i += 2 * lanes) {
+        Blocks(position / 2, out + i);
+        position = position + 2 * lanes;
+    }
+    unsigned int w[4];
+    for (; i + 1 < n; i += 2) {
+        Block(position / 2, w);
+        blockDoubles(w, out + i);
+        position = position + 2;
+    }
+    if (i < n) {
+        out[i] = RandomUniformDbl();
+    }
+}
+
+unsigned long long PhiloxRNG::GetPosition() { return position; }
+
+void PhiloxRNG::SetPosition(unsigned long long pos) {
+    position = pos;
+    if (position % 2 == 1) {
+        unsigned int w[4];
+        Block(position / 2, w);
+        blockDoubles(w, pair);
+    }
+}
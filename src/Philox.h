@@ -0,0 +1,39 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include "RNG.h"
+
+/* COUNTER-BASED RANDOM NUMBERS (PHILOX4x32-10, SALMON ET AL. 2011)
+ * EVERY 128 BIT COUNTER IS MIXED WITH THE 64 BIT KEY IN TEN ROUNDS OF
+ * MULTIPLIES AND XORS INTO FOUR RANDOM 32 BIT WORDS, I.E. TWO DOUBLES. THE
+ * KEY IS THE SEED AND THE UPPER HALF OF THE COUNTER IS THE STREAM, SO THE
+ * n-TH NUMBER OF A STREAM IS A FUNCTION OF (seed, stream, n) ALONE: IT DOES
+ * NOT MATTER WHICH THREAD DRAWS IT OR WHAT WAS DRAWN FROM OTHER STREAMS, AND
+ * A STREAM CAN JUMP TO ANY POSITION
+ */
+class PhiloxRNG final : public RNG {
+
+  private:
+    unsigned int key[2] = {0, 0};
+    unsigned long long stream = 0;
+    unsigned long long position = 0; // numbers drawn so far
+
+    double pair[2] = {0, 0}; // the block that holds number position - 1
+
+    static const int lanes = 16; // blocks computed side by side in a fill
+    void Blocks(unsigned long long counter, double *out);
+
+  public:
+    // the four words of block number counter of the stream
+    void Block(unsigned long long counter, unsigned int out[4]);
+
+    void Init(unsigned long long seed, unsigned long long stream_id);
+    void InitCold(long seed) override;
+
+    double RandomUniformDbl() override;
+    void FillUniformDbl(double *out, int n) override;
+
+    unsigned long long GetPosition();
+    void SetPosition(unsigned long long pos);
+};
+#endif
@@ -0,0 +1,314 @@
+#include <cmath>
+#include <iostream>
+
+#include "Potential.h"
+
+/////////// ANALYTIC FORMS ////////////////
+
+double Potential::lenJonesEnergy(double r, double a) {
+    return 4 * a * (pow(1 / r, 12) - pow(1 / r, 6) + trunc_shift);
+}
+
+double Potential::lenJonesForce(double r, double a) {
+    return 24 * a / sigma * (2 * pow(1 / r, 13) - pow(1 / r, 7));
+}
+
+// the WCA potential is not dependent upon the binding affinity since it
+// serves the purpose of a soft disk interaction
+double Potential::WCA_energy(double r) {
+    double val = 0;
+    if (r <= wca_cut) {
+        val = 4 * (pow(1.0 / r, 12) - pow(1.0 / r, 6) + .25);
+    }
+    return val;
+}
+
+double Potential::WCA_force(double r) {
+    double val = 0;
+    if (r <= wca_cut) {
+        val = 24 / sigma * (2 * pow(1 / r, 13) - pow(1 / r, 7));
+    }
+    return val;
+}
+
+// NOTE: in order for this to be in 'reduced form' the energy must
+// be multiplied by the reduced temperature
+double Potential::springEnergy(double r, double a) {
+    return a * .5 * red_temp * k_spring * pow(r - rest_L, 2) *
+           exp(-.5 * k_spring * pow(r - rest_L, 2.0));
+}
+
+double Potential::springForce(double r, double a) {
+    return a * red_temp * k_spring * (r - rest_L) *
+           exp(-.5 * k_spring * pow(r - rest_L, 2)) *
+           (k_spring * .5 * pow(r - rest_L, 2) - 1);
+}
+
+double Potential::energy(double r, double a) {
+    double val = 0;
+    switch (interact_type) {
+    case 1:
+        val = lenJonesEnergy(r, a);
+        break;
+    case 2:
+        val = WCA_energy(r);
+        break;
+    case 3:
+        val = WCA_energy(r) + springEnergy(r, a);
+        break;
+    }
+    return val;
+}
+
+double Potential::force(double r, double a) {
+    double val = 0;
+    switch (interact_type) {
+    case 1:
+        val = lenJonesForce(r, a);
+        break;
+    case 2:
+        val = WCA_force(r);
+        break;
+    case 3:
+        val = WCA_force(r) + springForce(r, a);
+        break;
+    }
+    return val;
+}
+
+// dU/dr, only used to build the table
+double Potential::energyDeriv(double r, double a) {
+    double u = r - rest_L;
+    double e = exp(-.5 * k_spring * u * u);
+    double lj = -24 * (2 * pow(1 / r, 13) - pow(1 / r, 7));
+    double val = 0;
+
+    switch (interact_type) {
+    case 1:
+        val = a * lj;
+        break;
+    case 2:
+        val = (r <= wca_cut) ? lj : 0;
+        break;
+    case 3:
+        val = (r <= wca_cut) ? lj : 0;
+        val = val +
+              a * red_temp * k_spring * u * e * (1 - .5 * k_spring * u * u);
+        break;
+    }
+    return val;
+}
+
+// dF/dr, only used to build the table
+double Potential::forceDeriv(double r, double a) {
+    double u = r - rest_L;
+    double ku2 = k_spring * u * u;
+    double e = exp(-.5 * ku2);
+    double lj = 24 / sigma * (-26 * pow(1 / r, 14) + 7 * pow(1 / r, 8));
+    double val = 0;
+
+    switch (interact_type) {
+    case 1:
+        val = a * lj;
+        break;
+    case 2:
+        val = (r <= wca_cut) ? lj : 0;
+        break;
+    case 3:
+        val = (r <= wca_cut) ? lj : 0;
+        val = val + a * red_temp * k_spring * e *
+                        (-1 + 2.5 * ku2 - .5 * ku2 * ku2);
+        break;
+    }
+    return val;
+}
+
+// recall that the shift and tail correction only apply to the LJ force and
+// the WCA force
+void Potential::truncation_values() {
+    switch (interact_type) {
+    case 3:
+        // the spring decays like a gaussian, it may be cut off well before
+        // half the box
+        trunc_dist = .5 * box_L;
+        if (spring_cut > 0 && spring_cut < trunc_dist) {
+            trunc_dist = spring_cut;
+        }
+        break;
+    default:
+        trunc_dist = 2.5;
+        trunc_shift = -1 * (pow(1 / trunc_dist, 12) - pow(1 / trunc_dist, 6));
+        tail_corr = 3.141592654 * red_dens *
+                    (.4 * pow(1 / trunc_dist, 10) - pow(1 / trunc_dist, 4));
+        break;
+    }
+}
+
+int Potential::getInteract_Type() { return interact_type; }
+double Potential::getTruncDist() { return trunc_dist; }
+double Potential::getTruncShift() { return trunc_shift; }
+double Potential::getTailCorr() { return tail_corr; }
+double Potential::getWCA_Cut() { return wca_cut; }
+
+void Potential::initializePotential(Parameters *p) {
+    sigma = p->getSigma();
+    rest_L = p->getRestLength();
+    k_spring = p->getSprConst();
+    red_temp = p->getRedTemp();
+    red_dens = p->getRedDens();
+    box_L = p->getBoxLength();
+    spring_cut = p->getSpringCutoff();
+    interact_type = p->getInteract_Type();
+
+    wca_cut = pow(2.0, 1.0 / 6.0);
+    truncation_values();
+}
+
+/////////// TABULATED FORMS ////////////////
+
+void PotentialTable::addSegment(double r2_start, double r2_end, double d_r2) {
+    int n = int(ceil((r2_end - r2_start) / d_r2 - 1e-9));
+    if (n < 1) {
+        n = 1;
+    }
+    seg_r2[n_segments] = r2_start;
+    seg_inv[n_segments] = 1 / d_r2;
+    seg_first[n_segments] = (n_segments == 0) ? 0 : seg_first[0] + seg_n[0];
+    seg_n[n_segments] = n;
+    n_segments++;
+}
+
+// cubic hermite coefficients of every interval. the end points are nudged
+// into the interval so each side of the WCA cutoff uses its own branch
+void PotentialTable::fillCoefficients(int kind) {
+    double a = affinity[kind];
+    int n_intervals = seg_first[n_segments - 1] + seg_n[n_segments - 1];
+
+    energy_coef[kind].resize(4 * n_intervals);
+    force_coef[kind].resize(4 * n_intervals);
+
+    for (int seg = 0; seg < n_segments; seg++) {
+        double d_r2 = 1 / seg_inv[seg];
+
+        for (int k = 0; k < seg_n[seg]; k++) {
+            int i = seg_first[seg] + k;
+            double r_a = sqrt(seg_r2[seg] + k * d_r2) * (1 + 1e-12);
+            double r_b = sqrt(seg_r2[seg] + (k + 1) * d_r2) * (1 - 1e-12);
+
+            // values and derivatives with respect to r^2, scaled by the
+            // spacing
+            double e0 = pot->energy(r_a, a);
+            double e1 = pot->energy(r_b, a);
+            double de0 = pot->energyDeriv(r_a, a) / (2 * r_a) * d_r2;
+            double de1 = pot->energyDeriv(r_b, a) / (2 * r_b) * d_r2;
+
+            double f0 = pot->force(r_a, a);
+            double f1 = pot->force(r_b, a);
+            double df0 = pot->forceDeriv(r_a, a) / (2 * r_a) * d_r2;
+            double df1 = pot->forceDeriv(r_b, a) / (2 * r_b) * d_r2;
+
+            double *ce = &energy_coef[kind][4 * i];
+            ce[0] = e0;
+            ce[1] = de0;
+            ce[2] = 3 * (e1 - e0) - 2 * de0 - de1;
+            ce[3] = 2 * (e0 - e1) + de0 + de1;
+
+            double *cf = &force_coef[kind][4 * i];
+            cf[0] = f0;
+            cf[1] = df0;
+            cf[2] = 3 * (f1 - f0) - 2 * df0 - df1;
+            cf[3] = 2 * (f0 - f1) + df0 + df1;
+        }
+    }
+}
+
+bool PotentialTable::isActive() { return active; }
+
+// compares the table with the analytic forms. the relative errors are taken
+// from 0.8 sigma, below which a move is practically never accepted, and are
+// relative to at least one unit so the zeros of the potentials do not count
+void PotentialTable::accuracyReport(std::ostream &out) {
+    if (!active) {
+        return;
+    }
+    int n_samples = 100000;
+    double r_cut = sqrt(r2_max);
+
+    out << "tabulated potential: " << seg_n[0] << " intervals in r^2 on ["
+        << r_min << ", " << sqrt(seg_r2[0] + seg_n[0] / seg_inv[0]) << "]";
+    if (n_segments > 1) {
+        out << " and " << seg_n[1] << " up to " << r_cut;
+    }
+    out << std::endl;
+
+    for (int kind = 0; kind < 2; kind++) {
+        double abs_e = 0;
+        double abs_f = 0;
+        double rel_e = 0;
+        double rel_f = 0;
+
+        for (int k = 0; k < n_samples; k++) {
+            double r = r_min + (r_cut - r_min) * (k + 0.5) / n_samples;
+            double e = pot->energy(r, affinity[kind]);
+            double f = pot->force(r, affinity[kind]);
+            double err_e = fabs(energy(r * r, kind) - e);
+            double err_f = fabs(force(r * r, kind) - f);
+
+            abs_e = fmax(abs_e, err_e);
+            abs_f = fmax(abs_f, err_f);
+            if (r >= 0.8) {
+                rel_e = fmax(rel_e, err_e / fmax(fabs(e), 1.0));
+                rel_f = fmax(rel_f, err_f / fmax(fabs(f), 1.0));
+            }
+        }
+        out << "  affinity " << affinity[kind] << ": max energy error "
+            << abs_e << " (relative " << rel_e << "), max force error "
+            << abs_f << " (relative " << rel_f << ")" << std::endl;
+    }
+}
+
+void PotentialTable::initializeTable(Parameters *p, Potential *potential) {
+    pot = potential;
+    n_segments = 0;
+
+    int size = p->getTableSize();
+    int type = pot->getInteract_Type();
+    active = (size > 0 && type != 0);
+    if (!active) {
+        return;
+    }
+
+    affinity[0] = p->getRefAffinity();
+    affinity[1] = p->getRefAffinity() * p->getAffinityMult();
+
+    double r2_min = r_min * r_min;
+    r2_max = pow(pot->getTruncDist(), 2);
+
+    // the fine grid covers the core and, for the spring, a few widths past
+    // its rest length. the rest of the cutoff gets a coarse grid
+    double r2_split = r2_max;
+    if (type == 3) {
+        double r_split = p->getRestLength() + 4 / sqrt(p->getSprConst());
+        r2_split = fmin(r2_max, fmax(6.25, r_split * r_split));
+    }
+
+    // the spacing is chosen so that the WCA cutoff lands on a grid point
+    double d_r2 = (r2_split - r2_min) / size;
+    double wca2 = pow(pot->getWCA_Cut(), 2);
+    if (type != 1 && wca2 < r2_split) {
+        int below = int(round((wca2 - r2_min) / d_r2));
+        if (below < 1) {
+            below = 1;
+        }
+        d_r2 = (wca2 - r2_min) / below;
+    }
+    addSegment(r2_min, r2_split, d_r2);
+
+    double r2_fine = seg_r2[0] + seg_n[0] * d_r2;
+    if (r2_fine < r2_max) {
+        addSegment(r2_fine, r2_max, (r2_max - r2_fine) / size);
+    }
+
+    fillCoefficients(0);
+    fillCoefficients(1);
+}
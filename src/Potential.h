@@ -0,0 +1,135 @@
+#ifndef POTENTIAL_H
+#define POTENTIAL_H
+
+#include <cmath>
+#include <ostream>
+#include <vector>
+
+#include "Parameters.h"
+
+/* PAIR POTENTIALS SHARED BY THE INTERACTION AND PROPERTIES CLASSES
+ * ALL DISTANCES ARE CHARACTERISTIC DISTANCES r/sigma. THE FORCES ARE THE
+ * MAGNITUDE -dU/dr USED IN THE VIRIAL (THE LJ AND WCA FORCES CARRY A FACTOR
+ * 1/sigma). THE AFFINITY a IS THE BINDING AFFINITY OF THE PAIR
+ */
+class Potential {
+
+  private:
+    double sigma = 0;
+    double rest_L = 0;
+    double k_spring = 0;
+    double red_temp = 0;
+    double red_dens = 0;
+    double box_L = 0;
+    double spring_cut = 0; // 0 = half the box
+
+    int interact_type = 0;
+
+    double trunc_dist = 0;
+    double trunc_shift = 0;
+    double tail_corr = 0;
+    double wca_cut = 0; // 2^(1/6)
+
+  public:
+    void initializePotential(Parameters *p);
+    void truncation_values();
+
+    double lenJonesEnergy(double r, double a);
+    double lenJonesForce(double r, double a);
+    double WCA_energy(double r);
+    double WCA_force(double r);
+    double springEnergy(double r, double a);
+    double springForce(double r, double a);
+
+    // total energy and force of the current interaction type and their
+    // derivatives with respect to r
+    double energy(double r, double a);
+    double force(double r, double a);
+    double energyDeriv(double r, double a);
+    double forceDeriv(double r, double a);
+
+    int getInteract_Type();
+    double getTruncDist();
+    double getTruncShift();
+    double getTailCorr();
+    double getWCA_Cut();
+};
+
+/* TABULATED POTENTIAL
+ * ENERGY AND FORCE OF THE PARALLEL (kind 0, a = a_ref) AND ANTIPARALLEL
+ * (kind 1, a = a_ref * a_mult) PAIRS ARE STORED ON A UNIFORM GRID IN r^2. EACH
+ * INTERVAL HOLDS THE CUBIC HERMITE POLYNOMIAL THROUGH THE ANALYTIC VALUES AND
+ * DERIVATIVES AT ITS ENDS, SO A LOOKUP NEEDS NEITHER A SQUARE ROOT NOR A
+ * TRANSCENDENTAL CALL. THE WCA CUTOFF IS PLACED ON A GRID POINT SO THE KINK IN
+ * ITS FORCE IS REPRODUCED. THE LONG CUTOFF OF THE SPRING POTENTIAL (HALF THE
+ * BOX) IS COVERED BY A SECOND, COARSER GRID PAST THE SPRING SO THE CORE KEEPS
+ * ITS RESOLUTION
+ */
+class PotentialTable {
+
+  private:
+    Potential *pot = nullptr;
+    bool active = false;
+
+    double r_min = 0.5; // closer pairs fall back on the analytic forms
+    double r2_max = 0;
+
+    // grid of each segment: first r^2, 1 / spacing, first interval, intervals
+    int n_segments = 0;
+    double seg_r2[2] = {0, 0};
+    double seg_inv[2] = {0, 0};
+    int seg_first[2] = {0, 0};
+    int seg_n[2] = {0, 0};
+
+    double affinity[2] = {0, 0};
+
+    // 4 coefficients per interval, one array per kind
+    std::vector<double> energy_coef[2];
+    std::vector<double> force_coef[2];
+
+    void addSegment(double r2_start, double r2_end, double d_r2);
+    void fillCoefficients(int kind);
+    int interval(double r2, double *t);
+
+  public:
+    void initializeTable(Parameters *p, Potential *potential);
+
+    bool isActive();
+    double energy(double r2, int kind);
+    double force(double r2, int kind);
+
+    void accuracyReport(std::ostream &out);
+};
+
+// the lookups are defined here so they can be inlined into the pair loops
+
+// returns the interval holding r^2 and the position t in [0,1] within it
+inline int PotentialTable::interval(double r2, double *t) {
+    int seg = (n_segments > 1 && r2 >= seg_r2[1]);
+    double s = (r2 - seg_r2[seg]) * seg_inv[seg];
+    int k = int(s);
+    if (k >= seg_n[seg]) {
+        k = seg_n[seg] - 1; // r^2 on the cutoff itself
+    }
+    *t = s - k;
+    return seg_first[seg] + k;
+}
+
+inline double PotentialTable::energy(double r2, int kind) {
+    if (r2 < seg_r2[0]) {
+        return pot->energy(sqrt(r2), affinity[kind]);
+    }
+    double t = 0;
+    const double *c = &energy_coef[kind][4 * interval(r2, &t)];
+    return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+}
+
+inline double PotentialTable::force(double r2, int kind) {
+    if (r2 < seg_r2[0]) {
+        return pot->force(sqrt(r2), affinity[kind]);
+    }
+    double t = 0;
+    const double *c = &force_coef[kind][4 * interval(r2, &t)];
+    return c[0] + t * (c[1] + t * (c[2] + t * c[3]));
+}
+#endif
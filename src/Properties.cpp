@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include "Properties.h" 
 
@@ -7,63 +9,44 @@ double Properties::radDistance(double x1, double x2,
    return sqrt(pow(x2-x1,2) + pow(y2-y1,2)) / sigma;  
 }
 
-double Properties::lenJonesForce(double r, double c){
-    // r is really r/sigma
-    return 24 * c / sigma * (2 * pow(1 / r, 13) - pow(1 / r, 7));
+// shifts a separation onto its nearest periodic image
+double Properties::minImage(double d) {
+    return d - boxLength * floor(d / boxLength + 0.5);
 }
+
+// the analytic forms are shared with the Interaction class
 // Note: r is the characteristic length r/sigma
+double Properties::lenJonesForce(double r, double c) {
+    return potential.lenJonesForce(r, c);
+}
 double Properties::lenJonesEnergy(double r, double a) {
-    return 4 * a * (pow(1 / r, 12) - pow(1 / r, 6) + truncShift);
+    return potential.lenJonesEnergy(r, a);
 }
 
-// might be worth making a new class with different
-// types of energies and their associated forces
-// NOTE: THE BINDING AFFINITY SHOULD NOT BE ATTACHED TO THE 
-// WCA POTENTIAL SINCE THE WCA POTENTIAL IS SERVING THE 
+// NOTE: THE BINDING AFFINITY SHOULD NOT BE ATTACHED TO THE
+// WCA POTENTIAL SINCE THE WCA POTENTIAL IS SERVING THE
 // PURPOSE OF A SOFT DISK INTERACTION
-double Properties::WCA_force(double r) {
-    double val = 0;
-    // as usual... r = r/sigma
-    // if r > 2^1/6 then there is no force/potential energy
-    if (r <= pow(2.0, 1.0 / 6.0)) {
-        val = 24 / sigma * (2 * pow(1 / r, 13) - pow(1 / r, 7));
-    }
-    return val; // if the particles are further than sigma * 2^(1/6)
-}
-
-// the WCA energy is a piecewise potential
-double Properties::WCA_energy(double r) { // a behaves as the
-    double val = 0;                       // binding affinity
-    if (r <= pow(2.0, 1.0 / 6.0)) {
-        val = 4 * (pow(1 / r, 12) - pow(1 / r, 6) + .25);
-    }
-    return val;
-}
+double Properties::WCA_force(double r) { return potential.WCA_force(r); }
+double Properties::WCA_energy(double r) { return potential.WCA_energy(r); }
 
-double Properties::simple_spring_force(double r, double a){
-    return a * red_temp * k_spring * (r - rest_L) *
-           exp(-.5 * k_spring * pow(r - rest_L, 2)) *
-           (k_spring * .5 * pow(r - rest_L, 2) - 1);
+double Properties::simple_spring_force(double r, double a) {
+    return potential.springForce(r, a);
 }
-
 double Properties::simple_spring_energy(double r, double a) {
-    return a * .5 * red_temp * k_spring * pow(r - rest_L, 2) *
-           exp(-.5 * k_spring * pow(r - rest_L, 2.0));
+    return potential.springEnergy(r, a);
 }
 
+// the affinity of the pair tells the parallel (kind 0) and the antiparallel
+// (kind 1) tables apart
+int Properties::pairKind(double a) { return (a == a_ref) ? 0 : 1; }
+
 // calculates the total energy of current configuration
 void Properties::calcEnergy(double r, double a) {
     double val = 0;
-    switch (interact_type) {
-    case 1:
-        val = lenJonesEnergy(r, a);
-        break;
-    case 2:
-        val = WCA_energy(r);
-        break;
-    case 3:
-        val = WCA_energy(r) + simple_spring_energy(r, a);
-        break;
+    if (isTabulated()) {
+        val = table.energy(r * r, pairKind(a));
+    } else {
+        val = potential.energy(r, a);
     }
     f_energy = f_energy + val;
 }
@@ -71,18 +54,15 @@ void Properties::calcEnergy(double r, double a) {
 // sums the total virial of the current configuration
 void Properties::calcVirial(double x, double y, double r, double a) {
     double val = 0;
-    switch (interact_type) {
-    case 1:
-        val = lenJonesForce(r, a);
-        break;
-    case 2:
-        val = WCA_force(r);
-        break;
-    case 3:
-        val = WCA_force(r) + simple_spring_force(r, a);
-        break;
+    if (isTabulated()) {
+        val = table.force(r * r, pairKind(a));
+    } else {
+        val = potential.force(r, a);
     }
+    addVirial(x, y, r, val);
+}
 
+void Properties::addVirial(double x, double y, double r, double val) {
     // I temporarily change this to compute the avg virial per particle
     avg_force[0] = (x * val + avg_force[0] * force_num) / (1 + force_num);
     avg_force[1] = (y * val + avg_force[1] * force_num) / (1 + force_num);
@@ -90,9 +70,18 @@ void Properties::calcVirial(double x, double y, double r, double a) {
     f_r = f_r + r * val;
 }
 
-void Properties::updateNumDensity(double r, int ID) {
+// energy and virial of one pair with the pair potential chosen at startup
+template <class Pair>
+void Properties::addPair(double x, double y, double r, int kind) {
+    double r2 = r * r;
+    f_energy = f_energy + Pair::energy(pair_params, r2, kind);
+    addVirial(x, y, r, Pair::force(pair_params, r2, r, kind));
+}
+
+// the bin of r in the radial number densities, -1 if it has none
+int Properties::radialBin(double r) {
     int val = r / delta_r;
-    int index = 0;
+    int index = -1;
 
     if (r < 0.5 * boxLength) {
         if (r > (val + 0.5) * delta_r) {
@@ -100,7 +89,37 @@ void Properties::updateNumDensity(double r, int ID) {
         } else {
             index = val;
         }
+        // r just below half the box can round up past the last bin
+        if (index >= int(num_density.size())) {
+            index = -1;
+        }
+    }
+    return index;
+}
+
+// the bin of the separation x,y in the xy number densities, false if it has
+// none
+bool Properties::xyBin(double x, double y, int *ind_1, int *ind_2) {
+    double half_boxL = .5 * boxLength;
+    *ind_1 = (x + half_boxL) / cell_L; // cell_L = delta x = delta y
+    *ind_2 = (y + half_boxL) / cell_L;
+
+    if (fabs(x) < half_boxL - cell_L && fabs(y) < half_boxL - cell_L) {
+        if (x > (*ind_1 + 0.5) * cell_L - half_boxL) {
+            ++*ind_1;
+        }
+        if (y > (*ind_2 + 0.5) * cell_L - half_boxL) {
+            ++*ind_2;
+        }
+        return true;
+    }
+    return false;
+}
+
+void Properties::updateNumDensity(double r, int ID) {
+    int index = radialBin(r);
 
+    if (index >= 0) {
         switch (ID) {
         case 0:
             num_density[index] = num_density[index] + 1;
@@ -116,18 +135,10 @@ void Properties::updateNumDensity(double r, int ID) {
 }
 
 void Properties::calc_xy_dens(double x, double y, int ID) {
-    double half_boxL = .5 * boxLength;
-    int ind_1 = (x + half_boxL) / cell_L; // cell_L = delta x = delta y
-    int ind_2 = (y + half_boxL) / cell_L;
-
-    if (fabs(x) < half_boxL - cell_L && fabs(y) < half_boxL - cell_L) {
-        if (x > (ind_1 + 0.5) * cell_L - half_boxL) {
-            ++ind_1;
-        }
-        if (y > (ind_2 + 0.5) * cell_L - half_boxL) {
-            ++ind_2;
-        }
+    int ind_1 = 0;
+    int ind_2 = 0;
 
+    if (xyBin(x, y, &ind_1, &ind_2)) {
         // increment vales of appropriate number densities
         switch (ID) {
         case 0:
@@ -143,12 +154,26 @@ void Properties::calc_xy_dens(double x, double y, int ID) {
     }
 }
 
-void Properties::calcNonPerProp(std::vector<Particle> *particles) {
-    Particle curr_prt;
-    Particle comp_prt;
+// a pair at distance r counted by one sampling task: in all pairs and in the
+// parallel (ID 1) or antiparallel (ID 2) ones
+void Properties::countPair(DensityCounts *c, double r, int ID) {
+    int index = radialBin(r);
+    if (index >= 0) {
+        (*c->radial[0])[index] = (*c->radial[0])[index] + 1;
+        (*c->radial[ID])[index] = (*c->radial[ID])[index] + 1;
+    }
+}
 
-    // can probably remove the L
-    double LJ_constant = 0;
+void Properties::calcNonPerProp(ParticleStore *particles) {
+    if (!avg_force_particle.isOpen()) {
+        open_files();
+    }
+    (this->*non_per_prop)(particles);
+}
+
+template <class Pair>
+void Properties::calcNonPerPropT(ParticleStore *particles) {
+    int kind = 0; // parallel or antiparallel pair
     double r_dist = 0;
 
     // make sure that the free energy previously calculated is reset the free
@@ -162,23 +187,19 @@ void Properties::calcNonPerProp(std::vector<Particle> *particles) {
         avg_force[1] = 0;
         force_num = 0;
 
-        curr_prt = (*particles)[k];
-
         // set current x,y position
-        double x_curr = curr_prt.getX_Position();
-        double y_curr = curr_prt.getY_Position();
+        double x_curr = particles->getX_Position(k);
+        double y_curr = particles->getY_Position(k);
 
         // each particle-particle interaction
         for (int n = 0; n < n_particles; n++) {
 
-            comp_prt = (*particles)[n];
-
             // set comparison x,y position
-            double x_comp = comp_prt.getX_Position();
-            double y_comp = comp_prt.getY_Position();
+            double x_comp = particles->getX_Position(n);
+            double y_comp = particles->getY_Position(n);
 
             // the particle cannot interact with itself
-            if (curr_prt.getIdentifier() != comp_prt.getIdentifier()) {
+            if (n != k) {
                 r_dist = radDistance(x_curr, x_comp, y_curr, y_comp);
 
                 // updates overall number density
@@ -189,20 +210,18 @@ void Properties::calcNonPerProp(std::vector<Particle> *particles) {
                 // number density for parallel interactions if type != type:
                 // interaction of antiparallel microtubules updates number
                 // density for antiparallel interactions
-                if (curr_prt.getType() == comp_prt.getType()) {
-                    LJ_constant = a_ref;
+                if (particles->getType(k) == particles->getType(n)) {
+                    kind = 0;
                     updateNumDensity(r_dist, 1);
                     calc_xy_dens(x_comp - x_curr, y_comp - y_curr, 1);
-                } else if (curr_prt.getType() != comp_prt.getType()) {
-                    LJ_constant = a_ref * a_mult;
+                } else {
+                    kind = 1;
                     updateNumDensity(r_dist, 2);
                     calc_xy_dens(x_comp - x_curr, y_comp - y_curr, 2);
                 }
             }
             if (n > k && r_dist < truncDist) {
-                calcEnergy(r_dist, LJ_constant);
-                calcVirial(x_curr - x_comp, y_curr - y_comp, r_dist,
-                           LJ_constant);
+                addPair<Pair>(x_curr - x_comp, y_curr - y_comp, r_dist, kind);
             }
             //            calc_average_force(x_curr - x_comp, y_curr - y_comp,
             //            r_dist);
@@ -214,41 +233,307 @@ void Properties::calcNonPerProp(std::vector<Particle> *particles) {
     }
     avg_force_particle << "\n";
     //    close_files();
-    sum_Fdot_r.push_back(f_r);
-    sum_energy.push_back(f_energy);
+    recordSample();
 }
 
 void Properties::populateCellArray(
-    double x, double y, std::vector<std::vector<double>> *cellPositions) {
+    double x, double y, double cellPositions[][2]) {
 
     // defines the 8 images of the comparison particle's position
-    (*cellPositions)[0][0] = x;
-    (*cellPositions)[0][1] = y + boxLength;
-    (*cellPositions)[1][0] = x;
-    (*cellPositions)[1][1] = y - boxLength;
-    (*cellPositions)[2][0] = x + boxLength;
-    (*cellPositions)[2][1] = y;
-    (*cellPositions)[3][0] = x + boxLength;
-    (*cellPositions)[3][1] = y + boxLength;
-    (*cellPositions)[4][0] = x + boxLength;
-    (*cellPositions)[4][1] = y - boxLength;
-    (*cellPositions)[5][0] = x - boxLength;
-    (*cellPositions)[5][1] = y;
-    (*cellPositions)[6][0] = x - boxLength;
-    (*cellPositions)[6][1] = y + boxLength;
-    (*cellPositions)[7][0] = x - boxLength;
-    (*cellPositions)[7][1] = y - boxLength;
-}
-
-void Properties::calcPeriodicProp(std::vector<Particle> *particles) {
-    Particle curr_prt;
-    Particle comp_prt;
+    cellPositions[0][0] = x;
+    cellPositions[0][1] = y + boxLength;
+    cellPositions[1][0] = x;
+    cellPositions[1][1] = y - boxLength;
+    cellPositions[2][0] = x + boxLength;
+    cellPositions[2][1] = y;
+    cellPositions[3][0] = x + boxLength;
+    cellPositions[3][1] = y + boxLength;
+    cellPositions[4][0] = x + boxLength;
+    cellPositions[4][1] = y - boxLength;
+    cellPositions[5][0] = x - boxLength;
+    cellPositions[5][1] = y;
+    cellPositions[6][0] = x - boxLength;
+    cellPositions[6][1] = y + boxLength;
+    cellPositions[7][0] = x - boxLength;
+    cellPositions[7][1] = y - boxLength;
+}
+
+/* PERIODIC PROPERTIES FROM THE NEAREST IMAGE OF EVERY PAIR
+ * THE NUMBER DENSITIES ONLY EXTEND TO HALF THE BOX, SO THEY ONLY EVER SEE THE
+ * NEAREST IMAGE, AND WITH THE CUTOFF AT MOST HALF THE BOX THE SAME HOLDS FOR
+ * THE ENERGY AND THE VIRIAL
+ */
+template <class Pair>
+void Properties::calcMinImageProp(ParticleStore *particles) {
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+
+    int kind = 0;
+
+    f_energy = 0;
+    f_r = 0;
+
+    for (int k = 0; k < n_particles; k++) {
+        double x_curr = x_pos[k];
+        double y_curr = y_pos[k];
+
+        for (int n = 0; n < n_particles; n++) {
+            if (n == k) {
+                continue;
+            }
+            // separation from the current particle to the nearest image
+            double x_sep = minImage(x_pos[n] - x_curr);
+            double y_sep = minImage(y_pos[n] - y_curr);
+            double r_dist = sqrt(x_sep * x_sep + y_sep * y_sep) / sigma;
+
+            updateNumDensity(r_dist, 0);
+            calc_xy_dens(x_sep, y_sep, 0);
+
+            if (types[k] == types[n]) {
+                kind = 0;
+                updateNumDensity(r_dist, 1);
+                calc_xy_dens(x_sep, y_sep, 1);
+            } else {
+                kind = 1;
+                updateNumDensity(r_dist, 2);
+                calc_xy_dens(x_sep, y_sep, 2);
+            }
+
+            if (n > k && r_dist < truncDist) {
+                addPair<Pair>(-x_sep, -y_sep, r_dist, kind);
+            }
+        }
+    }
+    recordSample();
+}
+
+// the pairs of the particles of one block with all the others, as in
+// calcMinImageProp (periodic) or calcNonPerPropT
+template <class Pair, bool periodic>
+void Properties::sampleBlock(ParticleStore *particles, int block,
+                             DensityCounts *c) {
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+
+    double energy = 0;
+    double virial = 0;
+
+    int last = std::min(n_particles, (block + 1) * sample_block);
+    for (int k = block * sample_block; k < last; k++) {
+        double x_curr = x_pos[k];
+        double y_curr = y_pos[k];
+
+        // the running average of the virial of particle k, as in addVirial
+        double fx = 0;
+        double fy = 0;
+        int num = 0;
+
+        for (int n = 0; n < n_particles; n++, num++) {
+            if (n == k) {
+                continue;
+            }
+            double x_sep = x_pos[n] - x_curr;
+            double y_sep = y_pos[n] - y_curr;
+            double r_dist = 0;
+            if (periodic) {
+                x_sep = minImage(x_sep);
+                y_sep = minImage(y_sep);
+                r_dist = sqrt(x_sep * x_sep + y_sep * y_sep) / sigma;
+            } else {
+                r_dist = radDistance(x_curr, x_pos[n], y_curr, y_pos[n]);
+            }
+            int kind = (types[k] == types[n]) ? 0 : 1;
+            countPair(c, r_dist, kind + 1);
+
+            if (n > k && r_dist < truncDist) {
+                double r2 = r_dist * r_dist;
+                double val = Pair::force(pair_params, r2, r_dist, kind);
+                energy = energy + Pair::energy(pair_params, r2, kind);
+                virial = virial + r_dist * val;
+                fx = (-x_sep * val + fx * num) / (1 + num);
+                fy = (-y_sep * val + fy * num) / (1 + num);
+            }
+        }
+        part_force[2 * k] = fx;
+        part_force[2 * k + 1] = fy;
+    }
+    block_energy[block] = energy;
+    block_virial[block] = virial;
+}
+
+/* THE XY NUMBER DENSITIES OF ONE SAMPLING TASK
+ * TASK t COUNTS THE PAIRS IN ITS OWN BAND OF ROWS (ind_1) OF THE TOTALS, SO
+ * NO TASK NEEDS A COPY OF THEM. THE PARTNERS OF A PARTICLE WITH A SEPARATION
+ * IN THE BAND ARE FOUND IN by_x, THE PARTICLES SORTED BY x, IN A WINDOW A
+ * CELL WIDER THAN THE BAND ON EITHER SIDE (AND ITS IMAGES ONE BOX TO EITHER
+ * SIDE IN THE PERIODIC BOX). xyBin THEN DECIDES THE ROW OF EVERY PAIR AS IN
+ * THE SERIAL LOOPS
+ */
+template <bool periodic>
+void Properties::sampleXY_Band(ParticleStore *particles, int task) {
+    const double *x_pos = particles->getX_Positions();
+    const double *y_pos = particles->getY_Positions();
+    const int *types = particles->getTypes();
+
+    int n_rows = xy_num_density.size();
+    int first = task * n_rows / n_tasks;
+    int last = (task + 1) * n_rows / n_tasks;
+    double half_boxL = .5 * boxLength;
+    double low = (first - 1) * cell_L - half_boxL;
+    double high = (last + 1) * cell_L - half_boxL;
+
+    // a window as wide as the box holds every partner of the particle
+    bool all = periodic && high - low >= boxLength;
+    int n_images = (periodic && !all) ? 3 : 1;
+
+    auto before = [](const std::pair<double, int> &a, double x) {
+        return a.first < x;
+    };
+    for (int k = 0; k < n_particles; k++) {
+        double x_curr = x_pos[k];
+        double y_curr = y_pos[k];
+        double x_box = x_curr;
+        if (periodic) {
+            x_box = x_curr - boxLength * floor(x_curr / boxLength);
+        }
+
+        for (int i = 0; i < n_images; i++) {
+            double shift = (n_images == 3) ? (i - 1) * boxLength : 0;
+            int begin = 0;
+            int end = n_particles;
+            if (!all) {
+                begin = std::lower_bound(by_x.begin(), by_x.end(),
+                                         x_box + low + shift, before) -
+                        by_x.begin();
+                end = std::lower_bound(by_x.begin() + begin, by_x.end(),
+                                       x_box + high + shift, before) -
+                      by_x.begin();
+            }
+            for (int m = begin; m < end; m++) {
+                int n = by_x[m].second;
+                if (n == k) {
+                    continue;
+                }
+                double x_sep = x_pos[n] - x_curr;
+                double y_sep = y_pos[n] - y_curr;
+                if (periodic) {
+                    x_sep = minImage(x_sep);
+                    y_sep = minImage(y_sep);
+                }
+                int ind_1 = 0;
+                int ind_2 = 0;
+                if (!xyBin(x_sep, y_sep, &ind_1, &ind_2) || ind_1 < first ||
+                    ind_1 >= last) {
+                    continue;
+                }
+                std::vector<std::vector<double>> &kind =
+                    (types[k] == types[n]) ? par_xy_density
+                                           : antp_xy_density;
+                xy_num_density[ind_1][ind_2] = xy_num_density[ind_1][ind_2] + 1;
+                kind[ind_1][ind_2] = kind[ind_1][ind_2] + 1;
+            }
+        }
+    }
+}
+
+template <class Pair, bool periodic>
+void Properties::calcPropThreaded(ParticleStore *particles) {
+    int n_blocks = (n_particles + sample_block - 1) / sample_block;
+
+    // the particles by x, in the box if it is periodic
+    const double *x_pos = particles->getX_Positions();
+    for (int k = 0; k < n_particles; k++) {
+        double x = x_pos[k];
+        if (periodic) {
+            x = x - boxLength * floor(x / boxLength);
+        }
+        by_x[k] = std::make_pair(x, k);
+    }
+    std::sort(by_x.begin(), by_x.end());
+
+    // task t takes every n_tasks-th block, into counts of its own, and then
+    // its band of the xy number densities
+    auto task = [&](int t) {
+        for (int b = t; b < n_blocks; b = b + n_tasks) {
+            sampleBlock<Pair, periodic>(particles, b, &counts[t]);
+        }
+        sampleXY_Band<periodic>(particles, t);
+    };
+    pool.run(n_tasks, std::ref(task));
 
+    f_energy = 0;
+    f_r = 0;
+    for (int b = 0; b < n_blocks; b++) {
+        f_energy = f_energy + block_energy[b];
+        f_r = f_r + block_virial[b];
+    }
+    if (!periodic) {
+        for (int k = 0; k < n_particles; k++) {
+            avg_force[0] = part_force[2 * k];
+            avg_force[1] = part_force[2 * k + 1];
+            writeAvgForces();
+        }
+        avg_force_particle << "\n";
+    }
+    recordSample();
+}
+
+// the radial number densities of the tasks past the first, which count into
+// copies. the xy ones need none
+void Properties::initializeSampling(Parameters *p) {
+    if (n_tasks <= 0) {
+        return;
+    }
+    int n_copies = 3 * (n_tasks - 1);
+    task_radial.assign(n_copies, std::vector<double>(num_density.size(), 0));
+    counts.resize(n_tasks);
+    for (int t = 1; t < n_tasks; t++) {
+        for (int i = 0; i < 3; i++) {
+            counts[t].radial[i] = &task_radial[3 * (t - 1) + i];
+        }
+    }
+    counts[0].radial[0] = &num_density;
+    counts[0].radial[1] = &par_num_density;
+    counts[0].radial[2] = &antp_num_density;
+
+    int n_blocks = (n_particles + sample_block - 1) / sample_block;
+    block_energy.assign(n_blocks, 0);
+    block_virial.assign(n_blocks, 0);
+    part_force.assign(2 * n_particles, 0);
+    by_x.resize(n_particles);
+    pool.initializeThreadPool(n_tasks);
+}
+
+// adds the counts of the sampling tasks to the totals, in task order
+void Properties::mergeCounts() {
+    for (int t = 1; t < n_tasks; t++) {
+        for (int i = 0; i < 3; i++) {
+            std::vector<double> *radial = counts[t].radial[i];
+            std::vector<double> *total = counts[0].radial[i];
+            for (int k = 0; k < int(radial->size()); k++) {
+                (*total)[k] = (*total)[k] + (*radial)[k];
+                (*radial)[k] = 0;
+            }
+        }
+    }
+}
+
+void Properties::calcPeriodicProp(ParticleStore *particles) {
+    if (!avg_force_particle.isOpen()) {
+        open_files();
+    }
+    if (min_image) {
+        (this->*min_image_prop)(particles);
+        return;
+    }
+
+    // the cutoff is longer than half the box: sum over the explicit images
     double LJ_constant = 0;
     double r_dist = 0;
 
-    std::vector<std::vector<double>> cellPositions(9,
-                                                   std::vector<double>(2, 0));
+    double cellPositions[9][2] = {}; // the images of the other particle
     // make sure that the free energy previously calculated is reset
     // the free energy is only the energy that comes from the positions
     // within the configuration
@@ -256,23 +541,21 @@ void Properties::calcPeriodicProp(std::vector<Particle> *particles) {
     f_r = 0;
 
     for (int k = 0; k < n_particles; k++) {
-        curr_prt = (*particles)[k];
-
         // set current x,y position
-        double x_curr = curr_prt.getX_Position();
-        double y_curr = curr_prt.getY_Position();
+        double x_curr = particles->getX_Position(k);
+        double y_curr = particles->getY_Position(k);
+        int type = particles->getType(k);
 
         // takes into account each particle-particle interaction
         for (int n = 0; n < n_particles; n++) {
 
-            comp_prt = (*particles)[n];
-
             // set comparison x,y position
-            double x_comp = comp_prt.getX_Position();
-            double y_comp = comp_prt.getY_Position();
+            double x_comp = particles->getX_Position(n);
+            double y_comp = particles->getY_Position(n);
+            bool parallel = (type == particles->getType(n));
 
             // the particle cannot interact with itself
-            if (curr_prt.getIdentifier() != comp_prt.getIdentifier()) {
+            if (n != k) {
                 r_dist = radDistance(x_curr, x_comp, y_curr, y_comp);
 
                 // updates total radial num density and x,y num density
@@ -283,11 +566,11 @@ void Properties::calcPeriodicProp(std::vector<Particle> *particles) {
                 // and parallel num density is updated
                 // if type != type: interaction of antiparallel microtubules
                 // and antiparallel num density is updated
-                if (curr_prt.getType() == comp_prt.getType()) {
+                if (parallel) {
                     LJ_constant = a_ref;
                     updateNumDensity(r_dist, 1);
                     calc_xy_dens(x_comp - x_curr, y_comp - y_curr, 1);
-                } else if (curr_prt.getType() != comp_prt.getType()) {
+                } else {
                     LJ_constant = a_ref * a_mult;
                     updateNumDensity(r_dist, 2);
                     calc_xy_dens(x_comp - x_curr, y_comp - y_curr, 2);
@@ -296,34 +579,36 @@ void Properties::calcPeriodicProp(std::vector<Particle> *particles) {
 
             if (n > k) {
                 if (r_dist > truncDist) {
-                    populateCellArray(x_comp, y_comp, &cellPositions);
+                    populateCellArray(x_comp, y_comp, cellPositions);
                     for (int z = 0; z < 8; z++) {
                         // creates the 8 cell images
                         x_comp = cellPositions[z][0];
                         y_comp = cellPositions[z][1];
                         r_dist = radDistance(x_curr, x_comp, y_curr, y_comp);
 
+                        // seen from k and from n, once in each direction
+                        double dx = x_comp - x_curr;
+                        double dy = y_comp - y_curr;
                         for (int j = 0; j < 2; j++) {
                             updateNumDensity(r_dist, 0);
-                            calc_xy_dens(x_comp - x_curr, y_comp - y_curr, 0);
+                            calc_xy_dens(dx, dy, 0);
 
-                            if (curr_prt.getType() == comp_prt.getType()) {
+                            if (parallel) {
                                 updateNumDensity(r_dist, 1);
-                                calc_xy_dens(x_comp - x_curr, y_comp - y_curr,
-                                             1);
-                            } else if (curr_prt.getType() !=
-                                       comp_prt.getType()) {
+                                calc_xy_dens(dx, dy, 1);
+                            } else {
                                 updateNumDensity(r_dist, 2);
-                                calc_xy_dens(x_comp - x_curr, y_comp - y_curr,
-                                             2);
+                                calc_xy_dens(dx, dy, 2);
                             }
+                            dx = -dx;
+                            dy = -dy;
                         }
+                        // the pair is only visited once (n > k), so unlike
+                        // the densities it is only counted once
                         if (r_dist < truncDist) {
-                            for (int j = 0; j < 2; j++) {
-                                calcEnergy(r_dist, LJ_constant);
-                                calcVirial(x_curr - x_comp, y_curr - y_comp,
-                                           r_dist, LJ_constant);
-                            }
+                            calcEnergy(r_dist, LJ_constant);
+                            calcVirial(x_curr - x_comp, y_curr - y_comp,
+                                       r_dist, LJ_constant);
                         }
                     }
                 } else {
@@ -334,8 +619,7 @@ void Properties::calcPeriodicProp(std::vector<Particle> *particles) {
             }
         }
     }
-    sum_Fdot_r.push_back(f_r);
-    sum_energy.push_back(f_energy);
+    recordSample();
 }
 
 // try to find a way to combine this calculation with the virial calculation
@@ -384,29 +668,39 @@ double Properties::calcPressure() {
     double avgEnergy = 0;
     double redPressure = 0;
 
-    double len = double(sum_Fdot_r.size()); // the pressure correction is
-                                            // added in the analysis code
-    for (int k = 0; k < len; k++) {
-        avgEnergy = avgEnergy + sum_Fdot_r[k];
-    }
-    avgEnergy = avgEnergy / len;
+    // the pressure correction is added in the analysis code
+    avgEnergy = virial_stats.getMean();
     redPressure = redDens * (red_temp + avgEnergy / (2 * n_particles));
     return redPressure;
 }
 
-double Properties::calcAvgEnergy() {
-    double len = 0;
-    double avgEnergy = 0;
+// a value of one of the series: written straight to its file, which is
+// opened with the first value, and added to its averages
+void Properties::addToSeries(OutputFile *file, const char *name,
+                             BlockAverage *stats, double val) {
+    if (!file->isOpen()) {
+        file->open(output_prefix + name);
+    }
+    (*file) << val << " ";
+    stats->add(val);
+}
 
-    len = double(sum_energy.size());
+// the virial and energy of a sample, once its pairs are summed
+void Properties::recordSample() {
+    addToSeries(&virial_file, "forces.txt", &virial_stats, f_r);
+    pressure_stats.add(redDens * (red_temp + f_r / (2 * n_particles)));
+    if (!energy_every_sweep) {
+        recordEnergy(f_energy);
+    }
+}
 
-    for (int k = 0; k < len; k++) {
-        avgEnergy = avgEnergy + sum_energy[k]; // sum all terms in the
-    }                                          // energy vector to compute
-    avgEnergy = avgEnergy / len;               // the average energy
-    return avgEnergy;                          // of the whole config
+// energy of the configuration after a sweep, from the running total
+void Properties::recordEnergy(double energy) {
+    addToSeries(&energy_file, "energies.txt", &energy_stats, energy);
 }
 
+double Properties::calcAvgEnergy() { return energy_stats.getMean(); }
+
 void Properties::writeAvgForces() {
     for (int k = 0; k < 2; ++k) {
         avg_force_particle << avg_force[k] << " ";
@@ -414,10 +708,96 @@ void Properties::writeAvgForces() {
 }
 
 void Properties::writeProperties() {
-    double len = 0;
+    // the series were written as they were sampled, the files are only
+    // created here if there were no samples at all
+    if (!virial_file.isOpen()) {
+        virial_file.open(output_prefix + "forces.txt");
+    }
+    if (!energy_file.isOpen()) {
+        energy_file.open(output_prefix + "energies.txt");
+    }
+    if (!avg_force_particle.isOpen()) {
+        open_files();
+    }
+    virial_file.close();
+    energy_file.close();
+
+    writeStatistics();
+    writeHistograms();
+    close_files();
+}
 
-    std::ofstream virial_file;
-    std::ofstream energy_file;
+// mean, standard error and autocorrelation time of the energy, the virial and
+// the pressure (without the tail correction), in units of their samples
+void Properties::writeStatistics() {
+    std::ofstream stats_file;
+    stats_file.open(output_prefix + "statistics.txt");
+
+    const char *names[3] = {"energy", "virial", "pressure"};
+    BlockAverage *stats[3] = {&energy_stats, &virial_stats, &pressure_stats};
+
+    stats_file << "# quantity samples mean std_error tau_int block_size"
+               << std::endl;
+    for (int q = 0; q < 3; q++) {
+        // a block size of 0 means the run was too short for the error to
+        // settle, and the error is that of the longest blocks
+        int level = stats[q]->getBlockLevel();
+        stats_file << names[q] << " " << stats[q]->getCount() << " "
+                   << stats[q]->getMean() << " " << stats[q]->getStdError()
+                   << " " << stats[q]->getTauInt() << " "
+                   << (level < 0 ? 0 : 1L << level) << std::endl;
+    }
+    stats_file.close();
+}
+
+BlockAverage *Properties::getEnergyStats() { return &energy_stats; }
+BlockAverage *Properties::getPressureStats() { return &pressure_stats; }
+
+// adds the number densities sampled by another run of the same system
+void Properties::addHistograms(Properties *other, double weight) {
+    other->mergeCounts();
+    for (int k = 0; k < int(num_density.size()); k++) {
+        num_density[k] = num_density[k] + weight * other->num_density[k];
+        par_num_density[k] =
+            par_num_density[k] + weight * other->par_num_density[k];
+        antp_num_density[k] =
+            antp_num_density[k] + weight * other->antp_num_density[k];
+    }
+    for (int k = 0; k < int(xy_num_density.size()); k++) {
+        for (int n = 0; n < int(xy_num_density[k].size()); n++) {
+            xy_num_density[k][n] =
+                xy_num_density[k][n] + weight * other->xy_num_density[k][n];
+            par_xy_density[k][n] =
+                par_xy_density[k][n] + weight * other->par_xy_density[k][n];
+            antp_xy_density[k][n] =
+                antp_xy_density[k][n] + weight * other->antp_xy_density[k][n];
+        }
+    }
+}
+
+const std::vector<double> &Properties::getNumDensity(int ID) {
+    mergeCounts();
+    if (ID == 1) {
+        return par_num_density;
+    } else if (ID == 2) {
+        return antp_num_density;
+    }
+    return num_density;
+}
+
+const std::vector<std::vector<double>> &Properties::getXY_Density(int ID) {
+    mergeCounts();
+    if (ID == 1) {
+        return par_xy_density;
+    } else if (ID == 2) {
+        return antp_xy_density;
+    }
+    return xy_num_density;
+}
+
+void Properties::writeHistograms() {
+    mergeCounts();
+    double len = 0;
 
     std::ofstream n_dens_file;
     std::ofstream par_dens_file;
@@ -427,24 +807,13 @@ void Properties::writeProperties() {
     std::ofstream par_xy_file;
     std::ofstream antp_xy_file;
 
-    virial_file.open("forces.txt"); // open each file that will be written to
-    energy_file.open("energies.txt");
-
-    n_dens_file.open("numDensity.txt");
-    par_dens_file.open("par_numDensity.txt");
-    antp_dens_file.open("antp_numDensity.txt");
+    n_dens_file.open(output_prefix + "numDensity.txt");
+    par_dens_file.open(output_prefix + "par_numDensity.txt");
+    antp_dens_file.open(output_prefix + "antp_numDensity.txt");
 
-    xy_dens_file.open("xy_numDensity.txt");
-    par_xy_file.open("par_xy_numDensity.txt");
-    antp_xy_file.open("antp_xy_numDensity.txt");
-
-    len = double(sum_Fdot_r.size()); // the force and energy vector are the same
-    for (int k = 0; k < len; k++) {  // size hence are put into one for-loop
-        virial_file << sum_Fdot_r[k] << " ";
-        energy_file << sum_energy[k] << " ";
-    }
-    virial_file.close();
-    energy_file.close();
+    xy_dens_file.open(output_prefix + "xy_numDensity.txt");
+    par_xy_file.open(output_prefix + "par_xy_numDensity.txt");
+    antp_xy_file.open(output_prefix + "antp_xy_numDensity.txt");
 
     len = double(num_density.size());
     for (int k = 0; k < len; k++) {           // all of the number density
@@ -467,30 +836,114 @@ void Properties::writeProperties() {
     xy_dens_file.close();
     par_xy_file.close();
     antp_xy_file.close();
-
-    close_files();
 }
 
-// recall that this function only applies to the LJ force
-// and the WCA force - maybe find a correction for the other
-// forces implemented
+// the truncation distance and shift are shared with the Interaction class
 void Properties::truncation_dist() {
+    truncDist = potential.getTruncDist();
+    truncShift = potential.getTruncShift();
+}
+
+// the histograms are saved merged, so a restart may use other sample_threads
+void Properties::saveState(CheckpointWriter *out) {
+    mergeCounts();
+    out->putVector(num_density);
+    out->putVector(par_num_density);
+    out->putVector(antp_num_density);
+    std::vector<std::vector<double>> *xy[3] = {
+        &xy_num_density, &par_xy_density, &antp_xy_density};
+    for (int ID = 0; ID < 3; ID++) {
+        for (int k = 0; k < int(xy[ID]->size()); k++) {
+            out->putVector((*xy[ID])[k]);
+        }
+    }
+    out->put(virial_stats);
+    out->put(energy_stats);
+    out->put(pressure_stats);
+
+    long long sizes[3] = {streamSize(&virial_file), streamSize(&energy_file),
+                          streamSize(&avg_force_particle)};
+    out->put(sizes);
+}
+
+void Properties::loadState(CheckpointReader *in) {
+    in->getVector(&num_density);
+    in->getVector(&par_num_density);
+    in->getVector(&antp_num_density);
+    std::vector<std::vector<double>> *xy[3] = {
+        &xy_num_density, &par_xy_density, &antp_xy_density};
+    for (int ID = 0; ID < 3; ID++) {
+        for (int k = 0; k < int(xy[ID]->size()); k++) {
+            in->getVector(&(*xy[ID])[k]);
+        }
+    }
+    in->get(&virial_stats);
+    in->get(&energy_stats);
+    in->get(&pressure_stats);
+
+    // a file that was not open yet is opened (and emptied) by its first value
+    long long sizes[3] = {-1, -1, -1};
+    in->get(&sizes);
+    OutputFile *files[3] = {&virial_file, &energy_file,
+                            &avg_force_particle};
+    const char *names[3] = {"forces.txt", "energies.txt",
+                            "avgForcePerParticle.txt"};
+    for (int f = 0; f < 3; f++) {
+        if (in->isGood() && sizes[f] >= 0) {
+            resumeStream(files[f], output_prefix + names[f], sizes[f]);
+        }
+    }
+}
+
+void Properties::setOutputWriter(OutputWriter *w) {
+    avg_force_particle.setWriter(w);
+    virial_file.setWriter(w);
+    energy_file.setWriter(w);
+}
+
+void Properties::open_files() {
+    avg_force_particle.open(output_prefix + "avgForcePerParticle.txt");
+}
+void Properties::close_files() { avg_force_particle.close(); }
+// assign private variable used in class
+template <class Pair> void Properties::setPairPolicy() {
+    min_image_prop = &Properties::calcMinImageProp<Pair>;
+    non_per_prop = &Properties::calcNonPerPropT<Pair>;
+    if (n_tasks > 0) {
+        min_image_prop = &Properties::calcPropThreaded<Pair, true>;
+        non_per_prop = &Properties::calcPropThreaded<Pair, false>;
+    }
+}
+
+// same choice as Interaction::selectPairPolicy
+void Properties::selectPairPolicy() {
+    if (isTabulated()) {
+        setPairPolicy<TabulatedPair>();
+        return;
+    }
     switch (interact_type) {
+    case 1:
+        setPairPolicy<LennardJonesPair>();
+        break;
+    case 2:
+        setPairPolicy<WCAPair>();
+        break;
     case 3:
-        truncDist = .5 * boxLength;
+        setPairPolicy<WCASpringPair>();
         break;
     default:
-        truncDist = 2.5;
-        truncShift = -1 * (pow(1 / truncDist, 12) - pow(1 / truncDist, 6));
+        setPairPolicy<HardDiskPair>();
         break;
     }
 }
 
-void Properties::open_files() {
-    avg_force_particle.open("avgForcePerParticle.txt");
+void Properties::setTabulated(bool t) {
+    tabulated = t;
+    selectPairPolicy();
 }
-void Properties::close_files() { avg_force_particle.close(); }
-// assign private variable used in class
+
+bool Properties::isTabulated() { return tabulated && table.isActive(); }
+
 void Properties::initializeProperties(Parameters *p) {
 
     boxLength = p->getBoxLength();
@@ -501,20 +954,37 @@ void Properties::initializeProperties(Parameters *p) {
 
     k_spring = p->getSprConst();
 
+    output_prefix = p->getOutputPrefix();
     interact_type = p->getInteract_Type();
+    energy_every_sweep = p->getTrackEnergy() && interact_type != 0;
     rest_L = p->getRestLength();
 
     a_ref = p->getRefAffinity();
     a_mult = p->getAffinityMult();
     std::cout << k_spring << "  " << a_ref << std::endl;
+    n_tasks = p->getSampleThreads();
 
-    // may be worth putting this chunk of code into a separate function
-    delta_r = sigma / 20; // this might not be the best way to define delta_r
-    cell_L = sigma / 20;
+    potential.initializePotential(p);
+    table.initializeTable(p, &potential);
+    pair_params.initializePairParams(p, &potential, &table);
+    selectPairPolicy();
 
     // determines truncation distance
     truncation_dist();
-    open_files();
+    min_image = (truncDist * sigma <= 0.5 * boxLength);
+
+    initializeHistograms(p);
+    initializeSampling(p);
+}
+
+// the number density histograms alone, without any output files open
+void Properties::initializeHistograms(Parameters *p) {
+    boxLength = p->getBoxLength();
+    sigma = p->getSigma();
+    output_prefix = p->getOutputPrefix();
+
+    delta_r = sigma / 20; // this might not be the best way to define delta_r
+    cell_L = sigma / 20;
 
     // define the various RDF vectors (dependent upon r)
     int arr_size = 0.5 * boxLength / delta_r + 1;
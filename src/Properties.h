@@ -3,10 +3,18 @@
 
 #include <cmath>
 #include <fstream>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "BlockAverage.h"
+#include "Checkpoint.h"
+#include "OutputWriter.h"
+#include "PairPotentials.h"
 #include "Parameters.h"
-#include "Particle.h"
+#include "ParticleStore.h"
+#include "Potential.h"
+#include "ThreadPool.h"
 
 class Properties {
 
@@ -16,10 +24,15 @@ class Properties {
 
     int force_num = 0;
     std::vector<double> avg_force{std::vector<double>(2, 0)};
-    std::ofstream avg_force_particle;
+    OutputFile avg_force_particle;
 
-    std::vector<double> sum_Fdot_r;
-    std::vector<double> sum_energy;
+    // the virial and energy of every sample are written out as they come and
+    // only their running averages are kept
+    OutputFile virial_file;
+    OutputFile energy_file;
+    BlockAverage virial_stats;
+    BlockAverage energy_stats;
+    BlockAverage pressure_stats;
 
     std::vector<double> num_density;
     std::vector<double> par_num_density;
@@ -49,16 +62,71 @@ class Properties {
 
     double boxLength = 0;
     int n_particles = 0;
+    bool min_image = false; // true if the cutoff is at most half the box
+    bool energy_every_sweep = false; // the energies come from recordEnergy
+    std::string output_prefix;       // put in front of every output file
 
     double redDens = 0;
     double red_temp = 0;
 
+    Potential potential;
+    PotentialTable table;
+    PairParams pair_params;
+    bool tabulated = true; // the table, if there is one, is used
+
+    // property loops instantiated for the pair potential chosen at startup
+    void (Properties::*min_image_prop)(ParticleStore *) = nullptr;
+    void (Properties::*non_per_prop)(ParticleStore *) = nullptr;
+
+    template <class Pair> void setPairPolicy();
+    template <class Pair>
+    void calcMinImageProp(ParticleStore *particles);
+    template <class Pair>
+    void calcNonPerPropT(ParticleStore *particles);
+    template <class Pair> void addPair(double x, double y, double r, int kind);
+    void addVirial(double x, double y, double r, double val);
+    void addToSeries(OutputFile *file, const char *name,
+                     BlockAverage *stats, double val);
+    void recordSample();
+
+    // sampling on several threads (sample_threads). the tasks count the
+    // radial number densities into counts of their own, added to the totals
+    // before they are written, and the xy number densities straight into the
+    // totals, each task in a band of rows (separations in x) of its own. the
+    // energy and virial are summed per block of particles and then over the
+    // blocks in order, whatever the number of threads
+    struct DensityCounts {
+        std::vector<double> *radial[3]; // all, parallel and antiparallel
+    };
+    static const int sample_block = 64; // particles per block
+
+    ThreadPool pool;
+    int n_tasks = 0;                  // 0 = the serial loops
+    std::vector<DensityCounts> counts; // task 0 counts into the totals
+    std::vector<std::vector<double>> task_radial;
+    std::vector<std::pair<double, int>> by_x; // x (in the box) and particle
+    std::vector<double> block_energy;
+    std::vector<double> block_virial;
+    std::vector<double> part_force; // average virial of each particle
+
+    int radialBin(double r);
+    bool xyBin(double x, double y, int *ind_1, int *ind_2);
+    void countPair(DensityCounts *c, double r, int ID);
+    template <class Pair, bool periodic>
+    void sampleBlock(ParticleStore *particles, int block, DensityCounts *c);
+    template <bool periodic>
+    void sampleXY_Band(ParticleStore *particles, int task);
+    template <class Pair, bool periodic>
+    void calcPropThreaded(ParticleStore *particles);
+    void initializeSampling(Parameters *p);
+    void mergeCounts();
+
   public:
     void initializeProperties(Parameters *p);
+    void initializeHistograms(Parameters *p);
     void truncation_dist();
 
-    void populateCellArray(double x, double y,
-                           std::vector<std::vector<double>> *cellPositions);
+    void populateCellArray(double x, double y, double cellPositions[][2]);
     double lenJonesEnergy(double r, double a);
     double lenJonesForce(double r, double a);
 
@@ -70,8 +138,15 @@ class Properties {
     void updateNumDensity(double r, int ID);
     void calc_xy_dens(double x, double y, int ID);
 
-    void calcPeriodicProp(std::vector<Particle> *particles);
-    void calcNonPerProp(std::vector<Particle> *particles);
+    double minImage(double d);
+    void calcPeriodicProp(ParticleStore *particles);
+    void selectPairPolicy();
+    // the samples take the potential of the moves, the table only if the
+    // interaction uses it (Interaction::isTabulated)
+    void setTabulated(bool t);
+    bool isTabulated();
+    void calcNonPerProp(ParticleStore *particles);
+    int pairKind(double a);
     void calcEnergy(double r, double c);
     void calcVirial(double x, double y, double r, double c);
 
@@ -79,13 +154,33 @@ class Properties {
 
     double calcPressure();
     double calcAvgEnergy();
+    void recordEnergy(double energy);
+    BlockAverage *getEnergyStats();
+    BlockAverage *getPressureStats();
     void calc_force_vec(double x, double y, double r,
                         std::vector<double> *F_vec);
     void avg_force_vec(std::vector<std::vector<double>> *F);
 
     void writeProperties();
+    void writeStatistics();
+
+    // the number densities of every sample so far, 0 = all pairs,
+    // 1 = parallel and 2 = antiparallel
+    const std::vector<double> &getNumDensity(int ID);
+    const std::vector<std::vector<double>> &getXY_Density(int ID);
+
+    // number densities merged over several independent runs, each counted
+    // with weight (1 / the number of runs for their average)
+    void addHistograms(Properties *other, double weight);
+    void writeHistograms();
     void writeAvgForces();
 
+    // the histograms, the averages and how far the files are written
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+
+    // the files of the samples are written on the thread of w
+    void setOutputWriter(OutputWriter *w);
     void open_files();
     void close_files();
 };
@@ -0,0 +1,25 @@
+#ifndef RNG_H
+#define RNG_H
+
+/* COMMON INTERFACE OF THE RANDOM NUMBER GENERATORS
+ * THE SIMULATION DRAWS ITS NUMBERS THROUGH THIS CLASS, SO THAT THE JKISS
+ * STREAM OF kiss.h AND THE COUNTER-BASED PHILOX STREAMS CAN BE SWAPPED FROM
+ * THE YAML FILE. FillUniformDbl GIVES THE SAME NUMBERS AS n CALLS TO
+ * RandomUniformDbl WOULD, BUT A GENERATOR CAN PRODUCE THEM MANY AT A TIME
+ */
+class RNG {
+  public:
+    virtual ~RNG() {}
+
+    virtual void InitCold(long seed) = 0;
+
+    // 53 bit double in [0,1)
+    virtual double RandomUniformDbl() = 0;
+
+    virtual void FillUniformDbl(double *out, int n) {
+        for (int i = 0; i < n; i++) {
+            out[i] = RandomUniformDbl();
+        }
+    }
+};
+#endif
@@ -0,0 +1,42 @@
+#include "RandomBuffer.h"
+
+void RandomBuffer::refill() {
+    source->FillUniformDbl(block.data(), block_size);
+    next = 0;
+}
+
+void RandomBuffer::setSource(RNG *rng) {
+    source = rng;
+    block.resize(block_size);
+    discard();
+}
+
+RNG *RandomBuffer::getSource() { return source; }
+
+void RandomBuffer::discard() { next = block_size; }
+
+void RandomBuffer::InitCold(long seed) {
+    source->InitCold(seed);
+    discard();
+}
+
+// what is left in the block first, then straight from the source
+void RandomBuffer::FillUniformDbl(double *out, int n) {
+    int i = 0;
+    for (; i < n && next < block_size; i++) {
+        out[i] = block[next++];
+    }
+    if (i < n) {
+        source->FillUniformDbl(out + i, n - i);
+    }
+}
+
+void RandomBuffer::saveState(CheckpointWriter *out) {
+    out->putVector(block);
+    out->put(next);
+}
+
+void RandomBuffer::loadState(CheckpointReader *in) {
+    in->getVector(&block);
+    in->get(&next);
+}
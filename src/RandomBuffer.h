@@ -0,0 +1,50 @@
+#ifndef RANDOMBUFFER_H
+#define RANDOMBUFFER_H
+
+#include <vector>
+
+#include "Checkpoint.h"
+#include "RNG.h"
+
+/* BUFFERED RANDOM NUMBERS
+ * THE MOVES DRAW THEIR NUMBERS FROM A BLOCK OF DOUBLES SMALL ENOUGH TO STAY
+ * IN THE L1 CACHE, WHICH IS REFILLED FROM THE SOURCE GENERATOR IN ONE CALL TO
+ * FillUniformDbl. A DRAW IS THEN A LOAD AND AN INCREMENT. SINCE A FILL GIVES
+ * THE SAME NUMBERS AS THE SINGLE DRAWS, EVERYTHING THAT DRAWS THROUGH THE
+ * BUFFER SEES THE SEQUENCE OF THE SOURCE ITSELF (JKISS OR PHILOX)
+ */
+class RandomBuffer final : public RNG {
+
+  private:
+    RNG *source = nullptr;
+    std::vector<double> block;
+    int next = 0; // the next number of block to hand out
+
+    void refill();
+
+  public:
+    static const int block_size = 512; // 4 KB of doubles
+
+    // draws from rng from now on, with nothing buffered
+    void setSource(RNG *rng);
+    RNG *getSource();
+
+    // forgets the buffered numbers, after the source has been reseeded
+    void discard();
+
+    void InitCold(long seed) override;
+
+    // defined here so that it inlines into the sweep
+    double RandomUniformDbl() override {
+        if (next == block_size) {
+            refill();
+        }
+        return block[next++];
+    }
+    void FillUniformDbl(double *out, int n) override;
+
+    // the numbers still buffered, not the state of the source
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+};
+#endif
@@ -0,0 +1,211 @@
+#include <fstream>
+#include <functional>
+#include <iostream>
+
+#include "ParticleStore.h"
+#include "Properties.h"
+#include "RdfAnalysis.h"
+
+void RdfAnalysis::initializeRdfAnalysis(Parameters *p, int threads) {
+    param = *p;
+    n_threads = (threads > 1) ? threads : 1;
+    pool.initializeThreadPool(n_threads);
+
+    n_particles = p->getNumParticles();
+    boxLength = p->getBoxLength();
+    total_dens = n_particles / (boxLength * boxLength);
+    affinity[0] = p->getRefAffinity();
+    affinity[1] = p->getRefAffinity() * p->getAffinityMult();
+
+    potential.initializePotential(p);
+    table.initializeTable(p, &potential);
+
+    // the bins of Properties::initializeHistograms
+    delta_r = p->getSigma() / 20;
+    cell_L = p->getSigma() / 20;
+    int arr_size = 0.5 * boxLength / delta_r + 1;
+    int val = boxLength / cell_L + 1;
+    for (int ID = 0; ID < 3; ID++) {
+        radial[ID].assign(arr_size, 0);
+        xy[ID].assign(val, std::vector<double>(val, 0));
+    }
+}
+
+// reads the whitespace separated numbers of a file into values, which has
+// to be filled exactly
+static bool readNumbers(std::string name, double *values, std::size_t n) {
+    std::ifstream file(name);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::size_t count = 0;
+    double v = 0;
+    while (file >> v) {
+        if (count == n) {
+            return false;
+        }
+        values[count++] = v;
+    }
+    return count == n;
+}
+
+bool RdfAnalysis::readHistograms(std::string prefix) {
+    const char *radial_names[3] = {"numDensity.txt", "par_numDensity.txt",
+                                   "antp_numDensity.txt"};
+    const char *xy_names[3] = {"xy_numDensity.txt", "par_xy_numDensity.txt",
+                               "antp_xy_numDensity.txt"};
+    for (int ID = 0; ID < 3; ID++) {
+        if (!readNumbers(prefix + radial_names[ID], radial[ID].data(),
+                         radial[ID].size())) {
+            return false;
+        }
+        // written row by row
+        int val = xy[ID].size();
+        std::vector<double> flat(val * val);
+        if (!readNumbers(prefix + xy_names[ID], flat.data(), flat.size())) {
+            return false;
+        }
+        for (int k = 0; k < val; k++) {
+            for (int n = 0; n < val; n++) {
+                xy[ID][k][n] = flat[k * val + n];
+            }
+        }
+    }
+    return true;
+}
+
+long RdfAnalysis::sampleTrajectory(TrajectoryReader *reader) {
+    // every frame is sampled on all of the threads
+    Parameters p = param;
+    p.setSampleThreads(n_threads);
+
+    Properties prop;
+    prop.initializeProperties(&p);
+
+    ParticleStore particles;
+    particles.resize(n_particles);
+    for (long f = 0; f < reader->getNumFrames(); f++) {
+        reader->readFrame(f, &particles);
+        if (param.getBound_Type() == 1) {
+            prop.calcPeriodicProp(&particles);
+        } else {
+            prop.calcNonPerProp(&particles);
+        }
+    }
+
+    for (int ID = 0; ID < 3; ID++) {
+        radial[ID] = prop.getNumDensity(ID);
+        xy[ID] = prop.getXY_Density(ID);
+    }
+    prop.writeProperties();
+
+    n_samples = reader->getNumFrames();
+    return n_samples;
+}
+
+void RdfAnalysis::setNumSamples(long n) { n_samples = n; }
+long RdfAnalysis::getNumSamples() { return n_samples; }
+
+// the count in a bin divided by the count of an ideal gas of the same density
+void RdfAnalysis::calcRDF() {
+    double pi = 3.141592654;
+    double norm = double(n_particles) * n_samples * total_dens;
+
+    std::function<void(int)> task = [&](int ID) {
+        int n_bins = radial[ID].size();
+        rdf[ID].assign(n_bins, 0);
+        for (int k = 0; k < n_bins; k++) {
+            // the first bin is the disk of radius delta_r / 2
+            double area = (k == 0) ? pi * delta_r * delta_r / 4
+                                   : 2 * pi * k * delta_r * delta_r;
+            rdf[ID][k] = radial[ID][k] / (area * norm);
+        }
+    };
+    pool.run(3, std::ref(task));
+}
+
+// the rows of the xy number densities are spread over the threads
+void RdfAnalysis::calcPCF() {
+    int val = xy[0].size();
+    double norm =
+        double(n_particles) * n_samples * total_dens * cell_L * cell_L;
+    for (int ID = 0; ID < 3; ID++) {
+        pcf[ID].assign(val, std::vector<double>(val, 0));
+    }
+
+    std::function<void(int)> task = [&](int k) {
+        for (int ID = 0; ID < 3; ID++) {
+            for (int n = 0; n < val; n++) {
+                pcf[ID][k][n] = xy[ID][k][n] / norm;
+            }
+        }
+    };
+    pool.run(val, std::ref(task));
+}
+
+// force of a pair at r, zero past the cutoff of the pair loops
+double RdfAnalysis::pairForce(double r, int kind) {
+    if (r >= potential.getTruncDist()) {
+        return 0;
+    }
+    if (table.isActive()) {
+        return table.force(r * r, kind);
+    }
+    return potential.force(r, affinity[kind]);
+}
+
+// trapezoid rule over the bins, leaving out the one at r = 0
+double RdfAnalysis::virialIntegral() {
+    double pi = 3.141592654;
+    double rho = param.getRedDens();
+
+    int n_bins = rdf[0].size();
+    double integral = 0;
+    for (int k = 1; k < n_bins; k++) {
+        double r = k * delta_r;
+        double f_par = pairForce(r, 0) * rdf[1][k];
+        double f_antp = pairForce(r, 1) * rdf[2][k];
+        double val = r * r * (f_par + f_antp);
+        double weight = (k == 1 || k == n_bins - 1) ? 0.5 : 1;
+        integral = integral + weight * val * delta_r;
+    }
+    return 0.5 * pi * rho * rho * integral;
+}
+
+// without the tail correction, like Properties::calcPressure
+double RdfAnalysis::calcPressure() {
+    return param.getRedDens() * param.getRedTemp() + virialIntegral();
+}
+
+const std::vector<double> &RdfAnalysis::getRDF(int ID) { return rdf[ID]; }
+const std::vector<std::vector<double>> &RdfAnalysis::getPCF(int ID) {
+    return pcf[ID];
+}
+
+void RdfAnalysis::writeResults(std::string prefix) {
+    std::ofstream rdf_file(prefix + "rdf.txt");
+    rdf_file << "# r g g_par g_antp, over " << n_samples << " samples\n";
+    for (int k = 0; k < int(rdf[0].size()); k++) {
+        rdf_file << k * delta_r << " " << rdf[0][k] << " " << rdf[1][k] << " "
+                 << rdf[2][k] << "\n";
+    }
+    rdf_file.close();
+
+    const char *pcf_names[3] = {"pcf.txt", "par_pcf.txt", "antp_pcf.txt"};
+    for (int ID = 0; ID < 3; ID++) {
+        std::ofstream pcf_file(prefix + pcf_names[ID]);
+        for (int k = 0; k < int(pcf[ID].size()); k++) {
+            for (int n = 0; n < int(pcf[ID][k].size()); n++) {
+                pcf_file << pcf[ID][k][n] << " ";
+            }
+            pcf_file << "\n";
+        }
+        pcf_file.close();
+    }
+
+    std::ofstream pressure_file(prefix + "pressure.txt");
+    pressure_file << "# ideal virial_integral pressure\n"
+                  << param.getRedDens() * param.getRedTemp() << " "
+                  << virialIntegral() << " " << calcPressure() << "\n";
+    pressure_file.close();
+}
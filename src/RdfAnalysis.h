@@ -0,0 +1,75 @@
+#ifndef RDFANALYSIS_H
+#define RDFANALYSIS_H
+
+#include <string>
+#include <vector>
+
+#include "Parameters.h"
+#include "Potential.h"
+#include "ThreadPool.h"
+#include "Trajectory.h"
+
+/* PAIR CORRELATIONS AFTER THE RUN
+ * THE RADIAL AND xy NUMBER DENSITIES ARE EITHER READ FROM THE FILES WRITTEN
+ * BY A RUN OR SAMPLED AGAIN FROM ITS trajectory.bin BY THE SAME Properties
+ * LOOPS THE SIMULATION USES (ON n_threads THREADS). THEY ARE TURNED INTO THE
+ * TOTAL, PARALLEL AND ANTIPARALLEL g(r), THE 2D PAIR CORRELATION g(x, y) AND
+ * THE PRESSURE FROM THE VIRIAL INTEGRAL
+ *   P = rho T + pi / 2 rho^2 int r^2 (F_par g_par + F_antp g_antp) dr
+ * WITH THE FORCES OF THE Potential (OR ITS TABLE) THE SIMULATION USED. ALL
+ * DISTANCES ARE r/sigma, AS IN Properties
+ */
+class RdfAnalysis {
+
+  private:
+    Parameters param;
+    Potential potential;
+    PotentialTable table;
+    ThreadPool pool;
+    int n_threads = 1;
+
+    int n_particles = 0;
+    double boxLength = 0;
+    double delta_r = 0;
+    double cell_L = 0;
+    double total_dens = 0; // particles per unit area
+    double affinity[2] = {0, 0};
+    long n_samples = 0;
+
+    // 0 = all pairs, 1 = parallel, 2 = antiparallel
+    std::vector<double> radial[3];
+    std::vector<std::vector<double>> xy[3];
+
+    std::vector<double> rdf[3];
+    std::vector<std::vector<double>> pcf[3];
+
+    double pairForce(double r, int kind);
+
+  public:
+    void initializeRdfAnalysis(Parameters *p, int threads);
+
+    // the number densities written with the given output prefix, false if
+    // one of them is missing or of the wrong size
+    bool readHistograms(std::string prefix);
+    // samples every frame of the trajectory, writing the energy and virial
+    // series of the frames with the output prefix of p
+    long sampleTrajectory(TrajectoryReader *reader);
+
+    // the samples the number densities were summed over
+    void setNumSamples(long n);
+    long getNumSamples();
+
+    void calcRDF();
+    void calcPCF();
+    double virialIntegral(); // the pi / 2 rho^2 int ... term
+    double calcPressure();
+
+    const std::vector<double> &getRDF(int ID);
+    const std::vector<std::vector<double>> &getPCF(int ID);
+
+    // rdf.txt (r, g, g_par, g_antp), pcf.txt, par_pcf.txt, antp_pcf.txt
+    // (row i at x = -L/2 + i dx, column j at y = -L/2 + j dx) and
+    // pressure.txt
+    void writeResults(std::string prefix);
+};
+#endif
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "ReplicaExchange.h"
+
+void ReplicaExchange::initializeReplicaExchange(std::string yamlFile,
+                                                Parameters *p) {
+    temps = p->getReplicaTemps();
+    output_prefix = p->getOutputPrefix();
+    n_updates = p->getUpdates();
+
+    // without an interval the replicas try to swap every data interval
+    interval = p->getSwapInterval();
+    if (interval <= 0) {
+        interval = p->getData_interval();
+    }
+
+    replicas.clear();
+    for (int m = 0; m < int(temps.size()); m++) {
+        std::ostringstream prefix;
+        prefix << p->getOutputPrefix() << "T" << temps[m] << "_";
+
+        Parameters rp = *p;
+        rp.setRedTemp(temps[m]);
+        rp.setStream(m + 1);
+        rp.setOutputPrefix(prefix.str());
+
+        replicas.emplace_back(new Simulation(yamlFile, rp));
+        replicas.back()->setQuiet(true);
+    }
+
+    // a stream past those of the replicas, as Simulation starts theirs
+    Parameters sp = *p;
+    sp.setStream(int(temps.size()) + 1);
+    if (sp.getRngType() == 1) {
+        philox.Init(sp.getSeed(), sp.getStream());
+        randVal = &philox;
+    } else {
+        kiss.InitCold(sp.getStreamSeed());
+        randVal = &kiss;
+    }
+
+    parity = 0;
+    n_attempts.assign(temps.size(), 0);
+    n_accepts.assign(temps.size(), 0);
+}
+
+double ReplicaExchange::swapProbability(double t_m, double t_n,
+                                        double u_mm, double u_nn,
+                                        double u_mn, double u_nm) {
+    double log_acc = u_mm / t_m + u_nn / t_n - u_mn / t_m - u_nm / t_n;
+    return log_acc >= 0 ? 1 : exp(log_acc);
+}
+
+// the sweeps [first, last) of every replica, one thread per replica
+void ReplicaExchange::runBlock(int first, int last) {
+    std::vector<std::thread> threads;
+    for (int m = 0; m < int(replicas.size()); m++) {
+        Simulation *sim = replicas[m].get();
+        threads.emplace_back([sim, first, last]() {
+            for (int sweepNum = first; sweepNum < last; sweepNum++) {
+                sim->runSweep(sweepNum);
+            }
+        });
+    }
+    for (int m = 0; m < int(threads.size()); m++) {
+        threads[m].join();
+    }
+}
+
+void ReplicaExchange::attemptSwaps() {
+    std::vector<double> u(replicas.size());
+    for (int m = 0; m < int(replicas.size()); m++) {
+        u[m] = replicas[m]->potentialEnergy();
+    }
+
+    // the configurations are exchanged to evaluate each under the other
+    // Hamiltonian, and exchanged back if the swap is rejected
+    for (int m = parity; m + 1 < int(replicas.size()); m += 2) {
+        ++n_attempts[m];
+        replicas[m]->swapConfiguration(replicas[m + 1].get());
+        double u_mn = replicas[m]->potentialEnergy();
+        double u_nm = replicas[m + 1]->potentialEnergy();
+        double prob = swapProbability(temps[m], temps[m + 1], u[m], u[m + 1],
+                                      u_mn, u_nm);
+        if (randVal->RandomUniformDbl() < prob) {
+            ++n_accepts[m];
+        } else {
+            replicas[m]->swapConfiguration(replicas[m + 1].get());
+        }
+    }
+    parity = 1 - parity;
+}
+
+void ReplicaExchange::writeSwapStats() {
+    std::ofstream swap_file;
+    swap_file.open(output_prefix + "replica_swaps.txt");
+
+    std::cout << "replica exchange every " << interval << " sweeps"
+              << std::endl;
+    for (int m = 0; m + 1 < int(replicas.size()); m++) {
+        double rate =
+            n_attempts[m] > 0 ? double(n_accepts[m]) / n_attempts[m] : 0;
+        swap_file << temps[m] << " " << temps[m + 1] << " " << n_attempts[m]
+                  << " " << n_accepts[m] << " " << rate << "\n";
+        std::cout << "T = " << temps[m] << " <-> " << temps[m + 1] << ": "
+                  << n_accepts[m] << " of " << n_attempts[m]
+                  << " swaps accepted (" << rate * 100 << "%)" << std::endl;
+    }
+    swap_file.close();
+}
+
+void ReplicaExchange::run() {
+    // the replicas go on together from the earliest sweep any of them was
+    // warm started at
+    int start = n_updates;
+    for (int m = 0; m < int(replicas.size()); m++) {
+        replicas[m]->initializeRun();
+        start = std::min(start, replicas[m]->getFirstSweep());
+    }
+    for (int m = 0; m < int(replicas.size()); m++) {
+        replicas[m]->setFirstSweep(start);
+    }
+
+    for (int first = start; first < n_updates; first += interval) {
+        int last = std::min(first + interval, n_updates);
+        runBlock(first, last);
+        std::cout << "current sweep: " << last << std::endl;
+        if (last < n_updates) {
+            attemptSwaps();
+        }
+    }
+
+    for (int m = 0; m < int(replicas.size()); m++) {
+        std::cout << "replica at T = " << temps[m] << ":" << std::endl;
+        replicas[m]->finishRun();
+    }
+    writeSwapStats();
+}
+
+int ReplicaExchange::getNumReplicas() { return replicas.size(); }
+RNG *ReplicaExchange::getSwapRNG() { return randVal; }
+long long ReplicaExchange::getNumAttempts(int pair) {
+    return n_attempts[pair];
+}
+long long ReplicaExchange::getNumAccepts(int pair) { return n_accepts[pair]; }
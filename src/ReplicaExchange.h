@@ -0,0 +1,65 @@
+#ifndef REPLICAEXCHANGE_H
+#define REPLICAEXCHANGE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Parameters.h"
+#include "Philox.h"
+#include "RNG.h"
+#include "Simulation.h"
+#include "kiss.h"
+
+/* PARALLEL TEMPERING
+ * ONE SIMULATION PER TEMPERATURE OF THE LADDER, EACH WITH ITS OWN RANDOM
+ * NUMBER STREAM, PROPERTIES AND OUTPUT FILES (PREFIXED BY ITS TEMPERATURE).
+ * THE REPLICAS RUN swap_interval SWEEPS AT A TIME ON THEIR OWN THREADS, THEN
+ * NEIGHBOURING TEMPERATURES TRY TO EXCHANGE THEIR CONFIGURATIONS, THE EVEN
+ * PAIRS AND THE ODD PAIRS IN TURN. THE SPRING ENERGY OF interactionType 3
+ * SCALES WITH THE TEMPERATURE, SO EVERY REPLICA HAS A HAMILTONIAN OF ITS OWN
+ * AND BOTH ARE EVALUATED ON BOTH CONFIGURATIONS: AN EXCHANGE OF x_m AND x_n
+ * IS ACCEPTED WITH min(1, exp(U_m(x_m)/T_m + U_n(x_n)/T_n - U_m(x_n)/T_m -
+ * U_n(x_m)/T_n))
+ */
+class ReplicaExchange {
+
+  private:
+    std::vector<std::unique_ptr<Simulation>> replicas;
+    std::vector<double> temps;
+    int n_updates = 0;
+    int interval = 0;
+    int parity = 0; // which neighbour pairs are tried next
+    std::string output_prefix; // of the run, before those of the replicas
+
+    // only for the swaps, a stream of the generator of the replicas past
+    // their own
+    KISSRNG kiss;
+    PhiloxRNG philox;
+    RNG *randVal = &kiss;
+
+    // per neighbour pair (m, m + 1)
+    std::vector<long long> n_attempts;
+    std::vector<long long> n_accepts;
+
+    void runBlock(int first, int last);
+    void attemptSwaps();
+    void writeSwapStats();
+
+  public:
+    void initializeReplicaExchange(std::string yamlFile, Parameters *p);
+
+    // probability to exchange the configurations of the replicas at t_m and
+    // t_n. u_mn is the energy of the configuration at t_n under the
+    // Hamiltonian of the replica at t_m
+    double swapProbability(double t_m, double t_n, double u_mm, double u_nn,
+                           double u_mn, double u_nm);
+
+    void run();
+
+    int getNumReplicas();
+    RNG *getSwapRNG();
+    long long getNumAttempts(int pair);
+    long long getNumAccepts(int pair);
+};
+#endif
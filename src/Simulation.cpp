@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include "AllocCounter.h"
 #include "Simulation.h"
 
 double Simulation::boltzmannFactor(double energy) {
@@ -8,51 +12,187 @@ double Simulation::boltzmannFactor(double energy) {
 Simulation::Simulation(std::string yf) {
     yamlFile = yf;
 
-    param.initializeParameters(yamlFile);   // initialize the parameters
-    interact.initializeInteraction(&param); // for the simulation
+    param.initializeParameters(yamlFile); // initialize the parameters
+    initializeSimulation();               // for the simulation
+}
+
+// a copy of parameters that were read (and possibly changed) elsewhere
+Simulation::Simulation(std::string yf, Parameters p) {
+    yamlFile = yf;
+    param = p;
+    initializeSimulation();
+}
+
+void Simulation::initializeSimulation() {
+    interact.initializeInteraction(&param);
     bound.initializeBoundary(&param);
     prop.initializeProperties(&param);
+    prop.setTabulated(interact.isTabulated());
+    energy.initializeEnergyTracker(&param);
+    chain.initializeEventChain(&param);
+    cluster.initializeClusterMove(&param);
+    cache.initializeConfigCache(&param);
+    output.initializeOutputWriter(&param);
+    prop.setOutputWriter(&output);
+    pos_file.setWriter(&output);
+    rad_dist_file.setWriter(&output);
+    part_energy_file.setWriter(&output);
+
+    // compares a tabulated potential with the analytic forms, if it is used
+    if (interact.isTabulated()) {
+        interact.getPotentialTable()->accuracyReport(std::cout);
+    } else if (interact.getPotentialTable()->isActive()) {
+        std::cout << "analytic potential: the delta-energy kernel does not "
+                     "use the table"
+                  << std::endl;
+    }
+    if (interact.getDeltaKernel()->isActive()) {
+        std::cout << "delta-energy kernel: "
+                  << kernelLevelName(interact.getDeltaKernel()->getLevel())
+                  << std::endl;
+    }
 
-    randVal.InitCold(param.getSeed());
+    if (param.getRngType() == 1) {
+        buffer.setSource(&philox);
+    } else {
+        buffer.setSource(&kiss);
+    }
+    randVal->InitCold(param.getSeed());
 
     n_particles = param.getNumParticles(); // initialize vector of
     particles.resize(n_particles);         // particles and set particle
     setParticleParams();                   // parameters
 
-    Particle prt;
+    // the particle types come from the yaml seed, so every stream of a run
+    // (replica or chain) has the same particles
+    if (param.getStream() > 0 && param.getRngType() == 1) {
+        philox.Init(param.getSeed(), param.getStream());
+        buffer.discard();
+    } else if (param.getStream() > 0) {
+        kiss.InitCold(param.getStreamSeed());
+        buffer.discard();
+    }
 
     red_temp = param.getRedTemp();
+    selectMovePolicy();
+    checker.initializeCheckerboard(&param, &interact);
+
+    if (param.getEventChain() && !chain.isActive()) {
+        std::cout << "event chains need hard disks in a periodic box, using "
+                     "single moves"
+                  << std::endl;
+    }
+    if (param.getSweepThreads() > 0 && !checker.isActive()) {
+        std::cout << "the checkerboard sweep needs soft particles in a "
+                     "periodic box at least four cells wide, using the "
+                     "serial sweep"
+                  << std::endl;
+    }
 }
 
-void Simulation::writePositions(std::ofstream *pos_file) {
-    Particle prt;
+void Simulation::setQuiet(bool q) { quiet = q; }
+void Simulation::setRestart(bool r) { restart = r; }
+int Simulation::getFirstSweep() { return first_sweep; }
+void Simulation::setFirstSweep(int s) {
+    first_sweep = s;
+    skipped_sweeps = s;
+}
+double Simulation::getRedTemp() { return red_temp; }
+Properties *Simulation::getProperties() { return &prop; }
+
+// total potential energy, from scratch: the pairs and the external well
+double Simulation::potentialEnergy() {
+    double total = bound.wellEnergy(&particles);
+    if (param.getInteract_Type() != 0) {
+        total = total + interact.totalEnergy(&particles, nullptr);
+    }
+    return total;
+}
 
-    if (pos_file->is_open()) {
+// the neighbour structures and running energy after the positions changed
+// under them
+void Simulation::refreshConfiguration() {
+    interact.buildNeighborLists(&particles);
+    energy.reset(&interact, &particles);
+    if (chain.isActive()) {
+        chain.build(&param, &particles);
+    }
+}
 
-        for (int k = 0; k < n_particles; k++) {
-            prt = particles[k];
+void Simulation::swapConfiguration(Simulation *other) {
+    particles.swapPositions(&other->particles);
+    refreshConfiguration();
+    other->refreshConfiguration();
+}
+
+void Simulation::writePositions(OutputFile *pos_file,
+                                ParticleStore *sample) {
+    if (pos_file->isOpen()) {
 
+        for (int k = 0; k < n_particles; k++) {
             // writes updated positions into position file
-            (*pos_file) << prt.getX_Position() << " ";
-            (*pos_file) << prt.getY_Position() << " ";
+            (*pos_file) << sample->getX_Position(k) << " ";
+            (*pos_file) << sample->getY_Position(k) << " ";
         }
-        (*pos_file) << std::endl;
+        (*pos_file) << "\n";
     } else {
         std::cout << "ERROR: THE .TXT FILE COULD NOT OPEN" << std::endl;
     }
 }
 
+void Simulation::writeParticleEnergies(OutputFile *energy_file,
+                                       const double *energies) {
+    for (int k = 0; k < n_particles; k++) {
+        (*energy_file) << energies[k] << " ";
+    }
+    (*energy_file) << "\n";
+}
+
+// writes out one sample and adds it to the properties, on the chain or on the
+// analysis thread
+void Simulation::analyseSample(int sweep, ParticleStore *sample,
+                               const double *energies) {
+    if (trajectory.isOpen()) {
+        trajectory.writeFrame(sweep, sample->getX_Positions(),
+                              sample->getY_Positions());
+    } else {
+        writePositions(&pos_file, sample);
+    }
+    if (energy.isPerParticle()) {
+        writeParticleEnergies(&part_energy_file, energies);
+    }
+    std::chrono::steady_clock::time_point sample_start =
+        std::chrono::steady_clock::now();
+    if (param.getBound_Type() == 1) {
+        prop.calcPeriodicProp(sample);
+    } else {
+        prop.calcNonPerProp(sample);
+    }
+    sample_time = sample_time + (std::chrono::steady_clock::now() -
+                                 sample_start);
+    n_samples++;
+}
+
+// a snapshot taken out of the ring, on the analysis thread
+void Simulation::analyseSnapshot(const Snapshot &snapshot) {
+    for (int k = 0; k < n_particles; k++) {
+        sampled.setX_Position(k, snapshot.x_position[k]);
+        sampled.setY_Position(k, snapshot.y_position[k]);
+        sampled.setType(k, snapshot.type[k]);
+    }
+    analyseSample(snapshot.sweep, &sampled, snapshot.energy.data());
+}
+
 // eventually replace this test with some sort of Catch2
 
 void Simulation::testSimulation() {
 
     n_particles = 4;
     particles.resize(n_particles);
-    Particle prt;
     double x = 0;
     double y = 0;
 
-    std::ofstream pos_file;
+    OutputFile pos_file;
     pos_file.open("positions.txt");
 
     //    for (int k = 0; k < 4; k++) {
@@ -76,7 +216,7 @@ void Simulation::testSimulation() {
     //    }
     //
     //    for (int k = 0; k < 1000; k++) {
-    //        writePositions(&pos_file);
+    //        writePositions(&pos_file, &particles);
     //    }
     x = -.5;
     y = -.5;
@@ -84,150 +224,489 @@ void Simulation::testSimulation() {
     //    prop.calc_average_force(x, y, r);
 }
 
-void Simulation::runSimulation() {
-
-    Particle prt;
+// the output files of a run from its first sweep
+void Simulation::openOutput() {
+    rad_dist_file.open(param.getOutputPrefix() + "radialDistance.txt");
+    if (param.getTrajectoryFormat() > 0) {
+        int precision = param.getTrajectoryFormat() == 2 ? 4 : 8;
+        trajectory.open(param.getOutputPrefix() + "trajectory.bin",
+                        n_particles, precision, param.getBoxLength(),
+                        param.getPhysicsHash(), particles.getTypes());
+    } else {
+        pos_file.open(param.getOutputPrefix() + "positions.txt");
+    }
+    if (energy.isPerParticle()) {
+        part_energy_file.open(param.getOutputPrefix() +
+                              "particleEnergies.txt");
+    }
+}
 
-    double n_rejects = 0;
-    double perc_rej = 0;
+// places the particles and indexes them, before the first sweep
+void Simulation::initializeRun() {
+
+    n_rejects = 0;
+    first_sweep = 0;
+    skipped_sweeps = 0;
+
+    // a restarted run takes the positions, the neighbour lists, the energies
+    // and the output files from its checkpoint instead
+    bool restarted = restart && restoreCheckpoint();
+    if (!restarted) {
+        double n_initial = n_particles;
+
+        // initializing particle positions
+        if (warmStart()) {
+            // the cached configuration, see warmStart
+        } else if (param.getInit_Type() == 0) {
+            bound.initialPosition(&particles, randVal);
+        } else if (param.getInit_Type() == 1) {
+            n_initial = bound.initialHexagonal(&particles);
+        } else if (param.getInit_Type() == 2) {
+            n_initial = bound.initialSquare(&particles);
+        }
 
-    std::ofstream rad_dist_file;
-    rad_dist_file.open("radialDistance.txt");
+        // print warning if the system has too many particles
+        if (n_initial < n_particles) {
+            std::cout << "ERROR: TOO MANY PARTICLES. INITIALIZED "
+                      << n_initial << " PARTICLES" << std::endl;
+        } else {
+            std::cout << "SUCCESSFULLY INITIALIZED " << n_initial
+                      << " PARTICLES" << std::endl;
+        }
+        openOutput(); // with the types the particles ended up with
+        interact.buildNeighborLists(&particles); // index the positions
+        energy.reset(&interact, &particles);
+    }
 
-    std::ofstream pos_file;
-    pos_file.open("positions.txt");
+    // event chains take the place of the single moves of a sweep
+    n_moves = n_particles;
+    if (chain.isActive()) {
+        if (!restarted) {
+            chain.build(&param, &particles);
+        }
+        n_moves = 0;
+        std::cout << "event chains of length " << chain.getChainLength()
+                  << ", " << chain.getChainsPerSweep() << " per sweep"
+                  << std::endl;
+    }
+    // the checkerboard sweep replaces the cluster moves as well
+    if (checker.isActive()) {
+        n_moves = 0;
+        std::cout << "checkerboard sweep of " << checker.getNumDomains()
+                  << " domains on " << checker.getNumThreads() << " threads"
+                  << std::endl;
+    }
+    start = std::chrono::steady_clock::now();
+    start_allocations = allocationCount();
+
+    // the analysis thread starts with the chain
+    if (param.getAnalysisBuffer() > 0) {
+        sampled.resize(n_particles);
+        analysis.initializeAnalysisPipeline(
+            param.getAnalysisBuffer(), n_particles, energy.isPerParticle(),
+            [this](const Snapshot &snapshot) { analyseSnapshot(snapshot); });
+    }
+}
 
-    double n_updates = param.getUpdates();
-    double n_initial = n_particles;
+std::string Simulation::checkpointPath() {
+    return param.getOutputPrefix() + "checkpoint.bin";
+}
 
-    // initializing particle positions
-    if (param.getInit_Type() == 0) {
-        bound.initialPosition(&particles, randVal);
-    } else if (param.getInit_Type() == 1) {
-        n_initial = bound.initialHexagonal(&particles);
-    } else if (param.getInit_Type() == 2) {
-        n_initial = bound.initialSquare(&particles);
+// everything restoreCheckpoint needs to go on with sweep next_sweep. the
+// parts are written in the order they are read back
+void Simulation::writeCheckpoint(int next_sweep) {
+    std::chrono::steady_clock::time_point write_start =
+        std::chrono::steady_clock::now();
+
+    // the samples still in the ring go into the properties and files first
+    analysis.drain();
+
+    std::chrono::duration<double> elapsed =
+        prior_time + (write_start - start);
+    checkpoint.clear();
+    checkpoint.put(next_sweep);
+    checkpoint.put(n_rejects);
+    checkpoint.put(n_samples);
+    checkpoint.put(skipped_sweeps);
+    checkpoint.put(elapsed.count());
+    checkpoint.put(sample_time.count());
+
+    particles.saveState(&checkpoint);
+    unsigned int kiss_state[4];
+    kiss.GetState(kiss_state);
+    checkpoint.put(kiss_state);
+    checkpoint.put(philox.GetPosition());
+    buffer.saveState(&checkpoint);
+
+    interact.saveState(&checkpoint);
+    energy.saveState(&checkpoint);
+    chain.saveState(&checkpoint);
+    cluster.saveState(&checkpoint);
+    checker.saveState(&checkpoint);
+    prop.saveState(&checkpoint);
+
+    long long sizes[3] = {streamSize(&pos_file), streamSize(&rad_dist_file),
+                          streamSize(&part_energy_file)};
+    checkpoint.put(sizes);
+    trajectory.saveState(&checkpoint);
+
+    if (!checkpoint.commit(checkpointPath(), param.getRunHash())) {
+        std::cout << "ERROR: THE CHECKPOINT " << checkpointPath()
+                  << " COULD NOT BE WRITTEN" << std::endl;
     }
+    n_checkpoints++;
+    checkpoint_time = checkpoint_time + (std::chrono::steady_clock::now() -
+                                         write_start);
+}
 
-    // print warning if the system has too many particles
-    if (n_initial < n_particles) {
-        std::cout << "ERROR: TOO MANY PARTICLES. INITIALIZED " << n_initial
-                  << " PARTICLES" << std::endl;
-    } else {
-        std::cout << "SUCCESSFULLY INITIALIZED " << n_initial << " PARTICLES"
-                  << std::endl;
+// the run as it was at its checkpoint, with the output files cut back to
+// where they were then. false if there is no checkpoint of this run
+bool Simulation::restoreCheckpoint() {
+    CheckpointReader in;
+    if (!in.open(checkpointPath(), param.getRunHash())) {
+        std::cout << "no checkpoint of this run in " << checkpointPath()
+                  << ", starting from the first sweep" << std::endl;
+        return false;
     }
-    for (int sweepNum = 0; sweepNum < n_updates; sweepNum++) {
-        for (int k = 0; k < n_particles; k++) {
-
-            // choose random particle
-            int curr_index = int(randVal.RandomUniformDbl() * n_particles);
-            prt = particles[curr_index];
 
-            // generate and set the x,y trial position
-            double x_trial = prt.x_trial(randVal.RandomUniformDbl());
-            double y_trial = prt.y_trial(randVal.RandomUniformDbl());
+    double elapsed = 0;
+    double sampling = 0;
+    in.get(&first_sweep);
+    in.get(&n_rejects);
+    in.get(&n_samples);
+    in.get(&skipped_sweeps);
+    in.get(&elapsed);
+    in.get(&sampling);
+    prior_time = std::chrono::duration<double>(elapsed);
+    sample_time = std::chrono::duration<double>(sampling);
+
+    particles.loadState(&in);
+    unsigned int kiss_state[4] = {0, 0, 0, 0};
+    unsigned long long philox_position = 0;
+    in.get(&kiss_state);
+    in.get(&philox_position);
+    kiss.SetState(kiss_state);
+    philox.SetPosition(philox_position);
+    buffer.loadState(&in);
+
+    interact.loadState(&in);
+    energy.loadState(&in);
+    if (chain.isActive()) {
+        chain.build(&param, &particles); // the sizes, the order is loaded
+    }
+    chain.loadState(&in);
+    cluster.loadState(&in);
+    checker.loadState(&in);
+    prop.loadState(&in);
+
+    long long sizes[3] = {-1, -1, -1};
+    in.get(&sizes);
+    OutputFile *files[3] = {&pos_file, &rad_dist_file, &part_energy_file};
+    const char *names[3] = {"positions.txt", "radialDistance.txt",
+                            "particleEnergies.txt"};
+    for (int f = 0; f < 3; f++) {
+        if (in.isGood() && sizes[f] >= 0) {
+            resumeStream(files[f], param.getOutputPrefix() + names[f],
+                         sizes[f]);
+        }
+    }
+    trajectory.loadState(&in, param.getOutputPrefix() + "trajectory.bin");
 
-            prt.setX_TrialPos(x_trial);
-            prt.setY_TrialPos(y_trial);
-            particles[curr_index] = prt;
+    // the checksum held, so it was written by another version of the code:
+    // the state is half loaded and the files of the run must not be touched
+    if (!in.isGood()) {
+        std::cout << "ERROR: THE CHECKPOINT " << checkpointPath()
+                  << " DOES NOT MATCH THIS VERSION OF THE SIMULATION"
+                  << std::endl;
+        std::exit(1);
+    }
+    writeParticleTypes(); // they may have come from the cache
+    std::cout << "restarted from " << checkpointPath() << " at sweep "
+              << first_sweep << std::endl;
+    return true;
+}
 
-            bool accept = 1;
-            double delta_energy = 0; // sets change in energy to 0
+// the types and positions of the closest configuration in the cache, after
+// which the run only re-equilibrates. false if the cache has none
+bool Simulation::warmStart() {
+    if (!cache.load(&particles)) {
+        if (cache.isActive()) {
+            std::cout << "no equilibrated configuration of this system in "
+                      << param.getConfigCache() << std::endl;
+        }
+        return false;
+    }
+    // another state point takes longer to settle
+    int sweeps = param.getWarmStartSweeps();
+    if (!cache.isExact()) {
+        sweeps = std::max(sweeps, param.getEq_sweep() / 10);
+    }
+    setFirstSweep(std::max(0, param.getEq_sweep() + 1 - sweeps));
+    writeParticleTypes();
 
-            if (param.getBound_Type() == 1) {
+    std::cout << "warm start from " << cache.getFound();
+    if (!cache.isExact()) {
+        std::cout << " (reduced density " << cache.getFoundDens()
+                  << ", reduced temp " << cache.getFoundTemp() << ")";
+    }
+    std::cout << ", " << param.getEq_sweep() + 1 - first_sweep
+              << " sweeps to re-equilibrate" << std::endl;
+    return true;
+}
 
-                // run sim with periodic boundaries
-                bound.periodicBoundary(&particles, curr_index);
-                prt = particles[curr_index];
+void Simulation::cacheConfiguration() {
+    if (cache.save(&particles)) {
+        std::cout << "equilibrated configuration cached in "
+                  << cache.cachePath(param.getPhysicsHash()) << std::endl;
+    } else {
+        std::cout << "ERROR: THE CONFIGURATION COULD NOT BE CACHED IN "
+                  << param.getConfigCache() << std::endl;
+    }
+}
 
-                // updates trial position in function then particle - particle
-                // interactions
-                x_trial = prt.getX_TrialPos();
-                y_trial = prt.getY_TrialPos();
+// the single particle moves of one sweep, instantiated for every boundary and
+// interaction (see MovePolicies.h)
+template <class Bound, class Pairs> void Simulation::moveSweep() {
+    for (int k = 0; k < n_moves; k++) {
+
+        // a share of the moves translate a whole cluster instead
+        if (cluster.isActive() &&
+            randVal->RandomUniformDbl() < cluster.getRatio()) {
+            if (!cluster.attempt(&particles, &interact, &bound, &energy,
+                                 randVal)) {
+                n_rejects++;
+            }
+            continue;
+        }
 
-                if (param.getInteract_Type() != 0) {
-                    delta_energy =
-                        interact.periodicInteraction(&particles, curr_index);
-                }
+        // choose random particle
+        int curr_index = int(randVal->RandomUniformDbl() * n_particles);
+
+        // generate and set the x,y trial position
+        double x_trial =
+            particles.x_trial(curr_index, randVal->RandomUniformDbl());
+        double y_trial =
+            particles.y_trial(curr_index, randVal->RandomUniformDbl());
+
+        particles.setX_TrialPos(curr_index, x_trial);
+        particles.setY_TrialPos(curr_index, y_trial);
+
+        double delta_energy = 0; // sets change in energy to 0
+        double pair_delta = 0;   // the part of it from the pairs alone
+
+        // the boundary first (a move through a rigid wall needs no pair
+        // energies), then the particle - particle interactions
+        bool accept =
+            Bound::trial(&bound, &particles, curr_index, &delta_energy) &&
+            Pairs::template trial<Bound>(&interact, &particles, curr_index,
+                                         &delta_energy, &pair_delta);
+
+        /* HARD DISKS IS A 0 - 1 PROBABILITY THUS A DELTA ENERGY IS NOT
+         * RETURNED THE CHANGE IN ENERGY IS RETURNED FROM LENJONES AND WCA
+         * POTENTIAL THIS TOTAL CHANGE IS SENT INTO THE BOLTZMANN FACTOR
+         * FUNCTION TO CALCULATE THE TOTAL PROBABILITY OF ACCEPTING THE
+         * TRIAL MOVE. IF THE TOTAL CHANGE < 0, THE MOVE IS ACCEPTED. ELSE A
+         * RANDOM NUMBER IS GENERATED TO DETERMINE WHETHER THE MOVE IS TO BE
+         * ACCEPTED
+         */
+
+        if (accept && delta_energy > 0) {
+            // compute acceptance probability
+            double total_prob = boltzmannFactor(delta_energy);
+
+            if (randVal->RandomUniformDbl() < total_prob) {
+                accept = 1;
             } else {
-                if (param.getBound_Type() == 0) {
-                    accept = bound.rigidBoundary(&particles, curr_index);
-                } else if (param.getBound_Type() == 2) {
-                    delta_energy = bound.externalWell(&particles, curr_index);
-                }
-
-                if (param.getInteract_Type() != 0) {
-                    delta_energy =
-                        delta_energy +
-                        interact.nonPeriodicInteraction(&particles, curr_index);
-                }
+                accept = 0;
             }
+        }
 
-            /* RUNS DIFFERENT TYPES OF PARTICLE-PARTICLE INTERACTIONS
-             * HARD DISKS IS A 0 - 1 PROBABILITY THUS A DELTA ENERGY IS NOT
-             * RETURNED THE CHANGE IN ENERGY IS RETURNED FROM LENJONES AND WCA
-             * POTENTIAL THIS TOTAL CHANGE IS SENT INTO THE BOLTZMANN FACTOR
-             * FUNCTION TO CALCULATE THE TOTAL PROBABILITY OF ACCEPTING THE
-             * TRIAL MOVE. IF THE TOTAL CHANGE < 0, THE MOVE IS ACCEPTED. ELSE A
-             * RANDOM NUMBER IS GENERATED TO DETERMINE WHETHER THE MOVE IS TO BE
-             * ACCEPTED
-             */
-
-            if (param.getInteract_Type() == 0 && accept == 1) {
-                accept = interact.hardDisks(&particles, curr_index);
-            }
+        // if trial move is accepted, update the position of current
+        // particle
+        if (accept) {
+            energy.acceptMove(&interact, &particles, curr_index,
+                              pair_delta);
+            particles.acceptTrial(curr_index);
+            interact.updateNeighborLists(&particles, curr_index);
+        } else {
+            n_rejects++; // keeps count of total moves rejected
+        }
+    }
+}
 
-            if (accept == 1 && delta_energy > 0) {
-                // compute acceptance probability
-                double total_prob = boltzmannFactor(delta_energy);
+template <class Bound> void Simulation::setMovePolicy() {
+    if (param.getInteract_Type() == 0) {
+        move_sweep = &Simulation::moveSweep<Bound, HardDiskMoves>;
+    } else {
+        move_sweep = &Simulation::moveSweep<Bound, SoftPairMoves>;
+    }
+}
 
-                if (randVal.RandomUniformDbl() < total_prob) {
-                    accept = 1;
-                } else {
-                    accept = 0;
-                }
-            }
+void Simulation::selectMovePolicy() {
+    switch (param.getBound_Type()) {
+    case 1:
+        setMovePolicy<PeriodicBox>();
+        break;
+    case 2:
+        setMovePolicy<HarmonicWell>();
+        break;
+    default:
+        setMovePolicy<RigidWalls>();
+        break;
+    }
+}
 
-            // if trial move is accepted, update the position of current
-            // particle and put back in particle vector
-            if (accept == 1) {
-                prt.setX_Position(x_trial);
-                prt.setY_Position(y_trial);
-                particles[curr_index] = prt;
-            } else {
-                n_rejects++; // keeps count of total moves rejected
-            }
-        }
+void Simulation::runSweep(int sweepNum) {
+    if (chain.isActive()) {
+        chain.sweep(&particles, randVal);
+    }
+    if (checker.isActive()) {
+        n_rejects = n_rejects +
+                    checker.sweep(&particles, &interact, &bound, &energy,
+                                  randVal);
+    }
+    (this->*move_sweep)();
 
-        if (sweepNum > param.getEq_sweep() &&
-            sweepNum % param.getData_interval() == 0) {
+    energy.endSweep(sweepNum, &interact, &particles);
+    if (energy.isActive() && sweepNum > param.getEq_sweep()) {
+        prop.recordEnergy(energy.getTotal());
+    }
+
+    if (sweepNum > param.getEq_sweep() &&
+        sweepNum % param.getData_interval() == 0) {
+        if (!quiet) {
             std::cout << "current sweep: " << sweepNum << std::endl;
-            writePositions(&pos_file);
-            if (param.getBound_Type() == 1) {
-                prop.calcPeriodicProp(&particles);
-            } else {
-                prop.calcNonPerProp(&particles);
-            }
+        }
+        const double *energies = nullptr;
+        if (energy.isPerParticle()) {
+            energies = energy.getParticleEnergies();
+        }
+        if (analysis.isActive()) {
+            analysis.push(sweepNum, &particles, energies);
+        } else {
+            analyseSample(sweepNum, &particles, energies);
         }
     }
+}
+
+// writes the properties and reports on the run
+void Simulation::finishRun() {
+    double n_updates = param.getUpdates() - skipped_sweeps; // that were run
+    double perc_rej = 0;
+
+    // the samples still in the ring are analysed before anything is written
+    analysis.finish();
+    trajectory.close();
+    pos_file.close();
+    rad_dist_file.close();
+    part_energy_file.close();
+
+    std::chrono::duration<double> elapsed =
+        prior_time + (std::chrono::steady_clock::now() - start);
+    long long n_allocations = allocationCount() - start_allocations;
+
     prop.writeProperties();
     //   std::cout << "The average energy of the system is " <<
     //   prop.calcAvgEnergy() << std::endl; std::cout << "The pressure of the
     //   system is " << prop.c alcPressure() << std::endl;
-    perc_rej = n_rejects / (n_updates * n_particles) * 100.0;
-    std::cout << perc_rej << "% of the moves were rejected." << std::endl;
+    if (chain.isActive()) {
+        std::cout << chain.getNumChains() << " event chains with "
+                  << chain.getNumEvents() << " collisions ("
+                  << double(chain.getNumEvents()) / chain.getNumChains()
+                  << " per chain)" << std::endl;
+    } else {
+        perc_rej = n_rejects / (n_updates * n_particles) * 100.0;
+        std::cout << perc_rej << "% of the moves were rejected." << std::endl;
+    }
+    if (cluster.getNumAttempts() > 0) {
+        std::cout << cluster.getNumAccepts() << " of "
+                  << cluster.getNumAttempts()
+                  << " cluster moves were accepted, "
+                  << cluster.getNumFrustrated()
+                  << " rejected on a frustrated link, average cluster size "
+                  << cluster.getAvgSize() << std::endl;
+    }
+    std::cout << n_updates / elapsed.count() << " sweeps per second"
+              << std::endl;
+    if (n_samples > 0) {
+        std::cout << n_samples << " property samples, "
+                  << sample_time.count() / n_samples << " seconds each"
+                  << std::endl;
+    }
+    BlockAverage *energy_stats = prop.getEnergyStats();
+    BlockAverage *pressure_stats = prop.getPressureStats();
+    if (energy_stats->getCount() > 1) {
+        std::cout << "average energy " << energy_stats->getMean() << " +- "
+                  << energy_stats->getStdError() << ", pressure "
+                  << pressure_stats->getMean() << " +- "
+                  << pressure_stats->getStdError() << " (statistics.txt)"
+                  << std::endl;
+    }
+    if (trajectory.getNumFrames() > 0) {
+        std::cout << trajectory.getNumFrames() << " frames, "
+                  << trajectory.getNumBytes() << " bytes written to "
+                  << param.getOutputPrefix() << "trajectory.bin" << std::endl;
+    }
+    std::cout << output.getNumBytes()
+              << " bytes of samples written on the output thread, the "
+                 "sampling waited "
+              << output.getBlockedTime() << " seconds for it" << std::endl;
+    if (output.hasFailed()) {
+        std::cout << "ERROR: NOT ALL OF THE SAMPLES COULD BE WRITTEN"
+                  << std::endl;
+    }
+    if (analysis.getNumPushes() > 0) {
+        std::cout << "analysis buffer of " << analysis.getNumSlots()
+                  << " snapshots: " << analysis.getAvgOccupancy()
+                  << " in use on average, at most "
+                  << analysis.getMaxOccupancy() << ", full on "
+                  << analysis.getNumFull() << " of "
+                  << analysis.getNumPushes() << " samples, the chain waited "
+                  << analysis.getBlockedTime() << " seconds" << std::endl;
+    }
+    if (n_checkpoints > 0) {
+        std::cout << n_checkpoints << " checkpoints of " << checkpoint.size()
+                  << " bytes written to " << checkpointPath() << ", "
+                  << checkpoint_time.count() << " seconds" << std::endl;
+    }
+    if (start_allocations >= 0) {
+        std::cout << n_allocations / n_updates
+                  << " heap allocations per sweep" << std::endl;
+    }
+
+    if (interact.getNumListBuilds() > 0) {
+        int n_builds = interact.getNumListBuilds();
+        std::cout << "the verlet lists were built " << n_builds
+                  << " times (once every " << n_updates / n_builds
+                  << " sweeps)" << std::endl;
+    }
+    if (energy.getNumChecks() > 0) {
+        std::cout << "the running energy was checked "
+                  << energy.getNumChecks() << " times, largest drift "
+                  << energy.getMaxDrift() << std::endl;
+    }
+}
+
+void Simulation::runSimulation() {
+    initializeRun();
+    int interval = param.getCheckpointInterval();
+    for (int sweepNum = first_sweep; sweepNum < param.getUpdates();
+         sweepNum++) {
+        runSweep(sweepNum);
+        if (sweepNum == param.getEq_sweep() && cache.isActive()) {
+            cacheConfiguration();
+        }
+        if (interval > 0 && (sweepNum + 1) % interval == 0) {
+            writeCheckpoint(sweepNum + 1);
+        }
+    }
+    finishRun();
 }
 
 // THIS IS THE NEXT PIECE TO BE ALTERED ////
 
 void Simulation::setParticleParams() {
 
-    Particle prt;
-
-    std::ofstream type_file;
-    type_file.open("particle_type.txt");
-
     YAML::Node node = YAML::LoadFile(yamlFile);
 
     int num_part_1 = node["type1_Particles"].as<int>();
@@ -244,12 +723,10 @@ void Simulation::setParticleParams() {
 
     double weight = sigma * sqrt(1 / (4 * param.getRedDens()));
     std::cout << "the stepping weight is: " << weight << std::endl;
-    prt.setStepWeight(weight);
 
     if (param.getInteract_Type() != 0) { // applies to the LJ and WCA potentials
         radius = .5 * sigma;
     }
-    prt.setRadius(radius);
 
     double num_1 = 0;
     double num_2 = 0;
@@ -258,7 +735,7 @@ void Simulation::setParticleParams() {
     for (int k = 0; k < n_particles; ++k) {
         if (num_1 < num_part_1 && num_2 < num_part_2) {
 
-            double n = randVal.RandomUniformDbl();
+            double n = randVal->RandomUniformDbl();
             if (n < ratio) {
                 type = 1;
                 ++num_1;
@@ -275,11 +752,18 @@ void Simulation::setParticleParams() {
         } else {
             std::cout << "count again" << std::endl;
         }
-        prt.setType(type);
-        prt.setIdentifier(k);
-        particles[k] = prt;
+        particles.setType(k, type);
+        particles.setRadius(k, radius);
+        particles.setStepWeight(k, weight);
+    }
+    writeParticleTypes();
+}
 
-        type_file << type << " ";
+void Simulation::writeParticleTypes() {
+    std::ofstream type_file;
+    type_file.open(param.getOutputPrefix() + "particle_type.txt");
+    for (int k = 0; k < n_particles; ++k) {
+        type_file << particles.getType(k) << " ";
     }
     type_file.close();
 }
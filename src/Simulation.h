@@ -1,16 +1,30 @@
 #ifndef SIMULATION_H
 #define SIMULATION_H
 
+#include <chrono>
 #include <fstream>
 #include <string>
 #include <vector>
 #include <yaml-cpp/yaml.h>
 
+#include "AnalysisPipeline.h"
 #include "Boundary.h"
+#include "Checkerboard.h"
+#include "Checkpoint.h"
+#include "ClusterMove.h"
+#include "ConfigCache.h"
+#include "EnergyTracker.h"
+#include "EventChain.h"
 #include "Interaction.h"
+#include "MovePolicies.h"
+#include "OutputWriter.h"
+#include "Philox.h"
 #include "Parameters.h"
-#include "Particle.h"
+#include "ParticleStore.h"
 #include "Properties.h"
+#include "RandomBuffer.h"
+#include "Trajectory.h"
+#include "kiss.h"
 
 class Simulation {
 
@@ -18,25 +32,113 @@ class Simulation {
     std::string yamlFile;
 
     Parameters param;
+    // writes the sample files, so it goes on until they are all closed
+    OutputWriter output;
     Interaction interact;
     Boundary bound;
     Properties prop;
+    EnergyTracker energy;
+    EventChain chain;
+    ClusterMove cluster;
+    Checkerboard checker;
 
-    std::vector<Particle> particles;
+    ParticleStore particles;
 
-    KISSRNG randVal;
+    // every number is drawn through the buffer, which is filled from one of
+    // the generators, chosen by rng_type
+    KISSRNG kiss;
+    PhiloxRNG philox;
+    RandomBuffer buffer;
+    RandomBuffer *randVal = &buffer;
 
     int n_particles = 0;
     double red_temp = 0;
 
+    // state of a run between sweeps
+    int n_moves = 0;
+    double n_rejects = 0;
+    bool quiet = false;
+    OutputFile pos_file;
+    TrajectoryWriter trajectory; // in place of pos_file if trajectory_format
+    OutputFile rad_dist_file;
+    OutputFile part_energy_file;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::duration<double> sample_time{0}; // in the property sampling
+    int n_samples = 0;
+    long long start_allocations = -1; // -1 if they are not counted
+
+    // with analysis_buffer the samples are analysed on a thread of their own,
+    // from a copy of the configuration taken out of the ring
+    AnalysisPipeline analysis;
+    ParticleStore sampled;
+
+    // a checkpoint every checkpoint_interval sweeps of runSimulation, from
+    // which a restarted run goes on as if it had not stopped
+    CheckpointWriter checkpoint;
+    bool restart = false;
+    int first_sweep = 0;
+    int n_checkpoints = 0;
+    std::chrono::duration<double> checkpoint_time{0}; // in writing them
+    std::chrono::duration<double> prior_time{0}; // of the run before restart
+
+    // a run of a system in the config_cache starts from its equilibrated
+    // configuration and skips most of the equilibration
+    ConfigCache cache;
+    int skipped_sweeps = 0;
+
+    void initializeSimulation();
+    void openOutput();
+    std::string checkpointPath();
+    bool restoreCheckpoint();
+    bool warmStart();
+    void writeParticleTypes();
+    void refreshConfiguration();
+    void analyseSample(int sweep, ParticleStore *sample,
+                       const double *energies);
+    void analyseSnapshot(const Snapshot &snapshot);
+
+    // the move loop instantiated for the boundary and interaction chosen at
+    // startup
+    void (Simulation::*move_sweep)() = nullptr;
+
+    template <class Bound, class Pairs> void moveSweep();
+    template <class Bound> void setMovePolicy();
+    void selectMovePolicy();
+
   public:
     Simulation(std::string yf);
+    Simulation(std::string yf, Parameters p);
 
     double boltzmannFactor(double delta_energy);
 
     void runSimulation();
+
+    // runSimulation in steps, for drivers that run several simulations
+    void initializeRun();
+    void runSweep(int sweepNum);
+    void finishRun();
+
+    // with restart, initializeRun continues from the checkpoint of the run
+    // if there is one, at sweep getFirstSweep
+    void setRestart(bool r);
+    int getFirstSweep();
+    void writeCheckpoint(int next_sweep);
+
+    // after a warm start, for drivers that go on from one sweep for all of
+    // their simulations
+    void setFirstSweep(int s);
+    // the configuration at the end of the equilibration into the cache
+    void cacheConfiguration();
+
+    void setQuiet(bool q);
+    double getRedTemp();
+    Properties *getProperties();
+    double potentialEnergy();
+    void swapConfiguration(Simulation *other);
     void setParticleParams();
-    void writePositions(std::ofstream *pos_file);
+    void writePositions(OutputFile *pos_file, ParticleStore *sample);
+    void writeParticleEnergies(OutputFile *energy_file,
+                               const double *energies);
     void testSimulation();
 };
 #endif
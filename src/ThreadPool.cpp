@@ -0,0 +1,63 @@
+#include "ThreadPool.h"
+
+// takes tasks until there are none left
+void ThreadPool::drain() {
+    for (int i = next++; i < n_tasks; i = next++) {
+        task(i);
+    }
+}
+
+void ThreadPool::work() {
+    long seen = 0;
+    while (true) {
+        std::unique_lock<std::mutex> guard(lock);
+        wake.wait(guard, [&]() { return stop || generation != seen; });
+        if (stop) {
+            return;
+        }
+        seen = generation;
+        guard.unlock();
+
+        drain();
+
+        guard.lock();
+        if (--n_busy == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run(int n, std::function<void(int)> f) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        task = f;
+        n_tasks = n;
+        next = 0;
+        n_busy = workers.size();
+        ++generation;
+    }
+    wake.notify_all();
+    drain();
+
+    std::unique_lock<std::mutex> guard(lock);
+    done.wait(guard, [&]() { return n_busy == 0; });
+}
+
+int ThreadPool::getNumThreads() { return workers.size() + 1; }
+
+void ThreadPool::initializeThreadPool(int n_threads) {
+    for (int t = 1; t < n_threads; t++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    wake.notify_all();
+    for (int t = 0; t < int(workers.size()); t++) {
+        workers[t].join();
+    }
+}
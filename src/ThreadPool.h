@@ -0,0 +1,46 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* FIXED POOL OF WORKER THREADS
+ * run(n, task) CALLS task(0) ... task(n - 1) SPREAD OVER THE WORKERS AND THE
+ * CALLING THREAD, AND RETURNS ONCE ALL OF THEM ARE DONE, SO EVERY CALL TO
+ * run IS ALSO A BARRIER. THE WORKERS ARE STARTED ONCE AND SLEEP BETWEEN CALLS
+ */
+class ThreadPool {
+
+  private:
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    std::function<void(int)> task;
+    int n_tasks = 0;
+    std::atomic<int> next{0};
+    int n_busy = 0;       // workers that have not finished the current call
+    long generation = 0;  // number of calls to run so far
+    bool stop = false;
+
+    void work();
+    void drain();
+
+  public:
+    ThreadPool() = default;
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    // n_threads counts the calling thread, so 1 starts no workers
+    void initializeThreadPool(int n_threads);
+    void run(int n, std::function<void(int)> f);
+
+    int getNumThreads();
+};
+#endif
@@ -0,0 +1,237 @@
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Trajectory.h"
+
+static_assert(sizeof(TrajectoryHeader) == 40,
+              "the header is written as it is laid out in memory");
+
+static const char trajectory_magic[8] = "MCTRAJ1";
+static const std::size_t write_block = 1 << 22; // bytes
+
+/////////////// WRITER ////////////////
+
+bool TrajectoryWriter::open(std::string path, int n, int prec,
+                            double box_length, std::uint64_t params_hash,
+                            const int *types) {
+    n_particles = n;
+    precision = (prec == 4) ? 4 : 8;
+    n_frames = 0;
+    n_bytes = 0;
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    TrajectoryHeader header;
+    std::memcpy(header.magic, trajectory_magic, sizeof(header.magic));
+    header.n_particles = n_particles;
+    header.precision = precision;
+    header.header_size =
+        (sizeof(TrajectoryHeader) + 4 * std::size_t(n_particles) + 63) / 64 *
+        64;
+    header.box_length = box_length;
+    header.params_hash = params_hash;
+
+    std::vector<char> head(header.header_size, 0);
+    std::memcpy(head.data(), &header, sizeof(header));
+    for (int k = 0; k < n_particles; k++) {
+        std::int32_t t = types[k];
+        std::memcpy(&head[sizeof(header) + 4 * k], &t, 4);
+    }
+    file.write(head.data(), head.size());
+    n_bytes = head.size();
+
+    // room for many frames, and at least one
+    std::size_t frame = 8 + 2 * std::size_t(n_particles) * precision;
+    buffer.resize(frame > write_block ? frame : write_block);
+    used = 0;
+    return true;
+}
+
+bool TrajectoryWriter::isOpen() { return file.is_open(); }
+
+void TrajectoryWriter::flush() {
+    file.write(buffer.data(), used);
+    used = 0;
+}
+
+void TrajectoryWriter::writeFrame(long sweep, const double *x,
+                                  const double *y) {
+    std::size_t frame = 8 + 2 * std::size_t(n_particles) * precision;
+    if (used + frame > buffer.size()) {
+        flush();
+    }
+
+    char *out = &buffer[used];
+    std::int64_t s = sweep;
+    std::memcpy(out, &s, 8);
+    out = out + 8;
+    for (int k = 0; k < n_particles; k++) {
+        if (precision == 8) {
+            std::memcpy(out, &x[k], 8);
+            std::memcpy(out + 8, &y[k], 8);
+        } else {
+            float xy[2] = {float(x[k]), float(y[k])};
+            std::memcpy(out, xy, 8);
+        }
+        out = out + 2 * precision;
+    }
+    used = used + frame;
+    n_frames++;
+    n_bytes = n_bytes + frame;
+}
+
+void TrajectoryWriter::close() {
+    if (file.is_open()) {
+        flush();
+        file.close();
+    }
+}
+
+TrajectoryWriter::~TrajectoryWriter() { close(); }
+
+long TrajectoryWriter::getNumFrames() { return n_frames; }
+long long TrajectoryWriter::getNumBytes() { return n_bytes; }
+
+void TrajectoryWriter::saveState(CheckpointWriter *out) {
+    if (file.is_open()) {
+        flush();
+    }
+    out->put(file.is_open());
+    out->put(n_particles);
+    out->put(precision);
+    out->put(n_frames);
+    out->put(n_bytes);
+}
+
+void TrajectoryWriter::loadState(CheckpointReader *in, std::string path) {
+    bool was_open = false;
+    in->get(&was_open);
+    in->get(&n_particles);
+    in->get(&precision);
+    in->get(&n_frames);
+    in->get(&n_bytes);
+    if (!in->isGood() || !was_open) {
+        return;
+    }
+    std::size_t frame = 8 + 2 * std::size_t(n_particles) * precision;
+    buffer.resize(frame > write_block ? frame : write_block);
+    used = 0;
+    resumeStream(&file, path, n_bytes);
+}
+
+/////////////// READER ////////////////
+
+bool TrajectoryReader::open(std::string path) {
+    close();
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || std::size_t(st.st_size) < sizeof(header)) {
+        close();
+        return false;
+    }
+    size = st.st_size;
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        close();
+        return false;
+    }
+    data = (const char *)mapped;
+
+    // the types of the particles follow the header, before the first frame
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, trajectory_magic, 8) != 0 ||
+        (header.precision != 4 && header.precision != 8) ||
+        header.n_particles <= 0 ||
+        header.header_size < std::int64_t(sizeof(header)) +
+                                 4 * std::int64_t(header.n_particles) ||
+        std::uint64_t(header.header_size) > size) {
+        close();
+        return false;
+    }
+    frame_size = 8 + 2 * std::size_t(header.n_particles) * header.precision;
+    // a frame cut short by a run that was stopped is left out
+    n_frames = (size - header.header_size) / frame_size;
+    return true;
+}
+
+void TrajectoryReader::close() {
+    if (data != nullptr) {
+        munmap((void *)data, size);
+        data = nullptr;
+    }
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    size = 0;
+    n_frames = 0;
+}
+
+TrajectoryReader::~TrajectoryReader() { close(); }
+
+int TrajectoryReader::getNumParticles() { return header.n_particles; }
+int TrajectoryReader::getPrecision() { return header.precision; }
+double TrajectoryReader::getBoxLength() { return header.box_length; }
+std::uint64_t TrajectoryReader::getParamsHash() { return header.params_hash; }
+long TrajectoryReader::getNumFrames() { return n_frames; }
+
+const std::int32_t *TrajectoryReader::getTypes() {
+    return (const std::int32_t *)(data + sizeof(header));
+}
+
+const char *TrajectoryReader::frame(long f) {
+    return data + header.header_size + f * frame_size;
+}
+
+long TrajectoryReader::getSweep(long f) {
+    std::int64_t s;
+    std::memcpy(&s, frame(f), 8);
+    return s;
+}
+
+// the frames start on 8 byte boundaries, so the coordinates are aligned
+const double *TrajectoryReader::getFrame(long f) {
+    if (header.precision != 8) {
+        return nullptr;
+    }
+    return (const double *)(frame(f) + 8);
+}
+
+const float *TrajectoryReader::getFrameSingle(long f) {
+    if (header.precision != 4) {
+        return nullptr;
+    }
+    return (const float *)(frame(f) + 8);
+}
+
+double TrajectoryReader::getX_Position(long f, int k) {
+    if (header.precision == 8) {
+        return getFrame(f)[2 * k];
+    }
+    return getFrameSingle(f)[2 * k];
+}
+
+double TrajectoryReader::getY_Position(long f, int k) {
+    if (header.precision == 8) {
+        return getFrame(f)[2 * k + 1];
+    }
+    return getFrameSingle(f)[2 * k + 1];
+}
+
+void TrajectoryReader::readFrame(long f, ParticleStore *particles) {
+    const std::int32_t *types = getTypes();
+    for (int k = 0; k < header.n_particles; k++) {
+        particles->setX_Position(k, getX_Position(f, k));
+        particles->setY_Position(k, getY_Position(f, k));
+        particles->setType(k, types[k]);
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Checkpoint.h"
+#include "ParticleStore.h"
+
+/* BINARY TRAJECTORY
+ * A HEADER FOLLOWED BY FRAMES OF ONE SIZE, SO A FRAME IS FOUND BY ITS INDEX
+ * AND THE FILE IS READ BY MAPPING IT INTO MEMORY INSTEAD OF PARSING IT. THE
+ * HEADER IS THE FIXED PART BELOW, THE TYPE OF EVERY PARTICLE (int32) AND
+ * ZEROS UP TO header_size, A MULTIPLE OF 64 BYTES. A FRAME IS THE SWEEP
+ * (int64) AND x0 y0 x1 y1 ... AS float64 OR float32, ALL LITTLE ENDIAN, SO
+ * THE FRAMES ARE A NUMPY ARRAY OF THE DTYPE
+ *   [('sweep', '<i8'), ('xy', '<f8', (n_particles, 2))]
+ * AT OFFSET header_size (SEE trajectory.py). THE NUMBER OF FRAMES FOLLOWS
+ * FROM THE SIZE OF THE FILE, SO THE FRAMES OF A RUN THAT WAS STOPPED EARLY
+ * CAN STILL BE READ
+ */
+struct TrajectoryHeader {
+    char magic[8];           // "MCTRAJ1" and a zero
+    std::int32_t n_particles;
+    std::int32_t precision;   // bytes per coordinate, 8 or 4
+    std::int64_t header_size; // bytes before the first frame
+    double box_length;
+    std::uint64_t params_hash; // Parameters::getPhysicsHash
+};
+
+class TrajectoryWriter {
+
+  private:
+    std::ofstream file;
+    // whole frames are gathered here and written out in large blocks
+    std::vector<char> buffer;
+    std::size_t used = 0;
+
+    int n_particles = 0;
+    int precision = 8;
+    long n_frames = 0;
+    long long n_bytes = 0;
+
+    void flush();
+
+  public:
+    ~TrajectoryWriter();
+
+    // precision is 8 for float64 or 4 for float32 coordinates
+    bool open(std::string path, int n, int prec, double box_length,
+              std::uint64_t params_hash, const int *types);
+    bool isOpen();
+    void writeFrame(long sweep, const double *x, const double *y);
+    void close();
+
+    long getNumFrames();
+    long long getNumBytes();
+
+    // the frames written so far, flushed to the file. loadState opens the
+    // file at path again after them, if it was open
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in, std::string path);
+};
+
+class TrajectoryReader {
+
+  private:
+    int fd = -1;
+    const char *data = nullptr; // the whole file, mapped read only
+    std::size_t size = 0;
+
+    TrajectoryHeader header;
+    std::size_t frame_size = 0;
+    long n_frames = 0;
+
+    const char *frame(long f);
+
+  public:
+    TrajectoryReader() = default;
+    TrajectoryReader(const TrajectoryReader &) = delete;
+    TrajectoryReader &operator=(const TrajectoryReader &) = delete;
+    ~TrajectoryReader();
+
+    // false if the file cannot be mapped or is not a trajectory
+    bool open(std::string path);
+    void close();
+
+    int getNumParticles();
+    int getPrecision();
+    double getBoxLength();
+    std::uint64_t getParamsHash();
+    long getNumFrames();
+    const std::int32_t *getTypes();
+
+    long getSweep(long f);
+    double getX_Position(long f, int k);
+    double getY_Position(long f, int k);
+
+    // x0 y0 x1 y1 ... of a frame, in the precision of the file (the other
+    // one returns nullptr)
+    const double *getFrame(long f);
+    const float *getFrameSingle(long f);
+
+    // the positions of frame f and the types into a store of the same size
+    void readFrame(long f, ParticleStore *particles);
+};
+#endif
@@ -0,0 +1,102 @@
+#include "VerletList.h"
+
+// rebuilds every list from the cell list, which has to be up to date with
+// the current positions
+void VerletList::build(ParticleStore *particles, CellList *grid) {
+    int cells[9];
+    double sx[9];
+    double sy[9];
+
+    int n_particles = particles->size();
+
+    active = half_skin > 0 && grid->isActive();
+    if (!active) {
+        return;
+    }
+
+    start.resize(n_particles + 1);
+    x_ref.resize(n_particles);
+    y_ref.resize(n_particles);
+    nbrs.clear();
+    shift_x.clear();
+    shift_y.clear();
+
+    for (int k = 0; k < n_particles; k++) {
+        double x = particles->getX_Position(k);
+        double y = particles->getY_Position(k);
+
+        x_ref[k] = x;
+        y_ref[k] = y;
+        start[k] = nbrs.size();
+
+        int num = grid->neighborCells(x, y, cells, sx, sy);
+        for (int c = 0; c < num; c++) {
+            for (int n = grid->getHead(cells[c]); n != -1;
+                 n = grid->getNext(n)) {
+                if (n == k) {
+                    continue;
+                }
+                double dx = particles->getX_Position(n) + sx[c] - x;
+                double dy = particles->getY_Position(n) + sy[c] - y;
+
+                if (dx * dx + dy * dy < list_cut * list_cut) {
+                    nbrs.push_back(n);
+                    shift_x.push_back(sx[c]);
+                    shift_y.push_back(sy[c]);
+                }
+            }
+        }
+    }
+    start[n_particles] = nbrs.size();
+    ++n_builds;
+}
+
+// true if x,y is within half a skin of the particle's reference position. the
+// raw displacement is used on purpose: a particle that is wrapped through a
+// periodic wall always forces a rebuild
+bool VerletList::withinSkin(int index, double x, double y) {
+    double dx = x - x_ref[index];
+    double dy = y - y_ref[index];
+    return dx * dx + dy * dy <= half_skin * half_skin;
+}
+
+bool VerletList::isActive() { return active; }
+int VerletList::getNumBuilds() { return n_builds; }
+int VerletList::getStart(int index) { return start[index]; }
+int VerletList::getEnd(int index) { return start[index + 1]; }
+int VerletList::getNeighbor(int n) { return nbrs[n]; }
+double VerletList::getShiftX(int n) { return shift_x[n]; }
+double VerletList::getShiftY(int n) { return shift_y[n]; }
+
+// the cutoff is given in absolute units (not r/sigma)
+void VerletList::initializeVerletList(Parameters *p, double cutoff) {
+    double skin = p->getVerletSkin() * p->getSigma();
+
+    half_skin = 0.5 * skin;
+    list_cut = cutoff + skin;
+    active = false;
+    n_builds = 0;
+}
+
+// active is only decided by the first build
+void VerletList::saveState(CheckpointWriter *out) {
+    out->put(active);
+    out->put(n_builds);
+    out->putVector(start);
+    out->putVector(nbrs);
+    out->putVector(shift_x);
+    out->putVector(shift_y);
+    out->putVector(x_ref);
+    out->putVector(y_ref);
+}
+
+void VerletList::loadState(CheckpointReader *in) {
+    in->get(&active);
+    in->get(&n_builds);
+    in->getVector(&start);
+    in->getVector(&nbrs);
+    in->getVector(&shift_x);
+    in->getVector(&shift_y);
+    in->getVector(&x_ref);
+    in->getVector(&y_ref);
+}
@@ -0,0 +1,50 @@
+#ifndef VERLETLIST_H
+#define VERLETLIST_H
+
+#include <vector>
+
+#include "CellList.h"
+#include "Checkpoint.h"
+#include "Parameters.h"
+#include "ParticleStore.h"
+
+/* PER-PARTICLE VERLET LISTS
+ * EVERY PARTICLE STORES THE PARTICLES WITHIN cutoff + skin OF IT AT THE LAST
+ * REBUILD, TOGETHER WITH THE PERIODIC IMAGE SHIFT OF EACH ENTRY. THE LISTS
+ * STAY EXACT AS LONG AS NO PARTICLE HAS MOVED MORE THAN HALF THE SKIN SINCE
+ * THE LAST REBUILD, WHICH IS CHECKED AGAINST THE STORED REFERENCE POSITIONS
+ */
+class VerletList {
+
+  private:
+    double half_skin = 0; // absolute units
+    bool active = false;
+    int n_builds = 0;
+
+    std::vector<int> start; // neighbours of k are nbrs[start[k]..start[k+1])
+    std::vector<int> nbrs;
+    std::vector<double> shift_x;
+    std::vector<double> shift_y;
+
+    std::vector<double> x_ref; // positions at the last rebuild
+    std::vector<double> y_ref;
+
+    double list_cut = 0;
+
+  public:
+    void initializeVerletList(Parameters *p, double cutoff);
+    void build(ParticleStore *particles, CellList *grid);
+    bool withinSkin(int index, double x, double y);
+
+    bool isActive();
+    int getNumBuilds();
+    int getStart(int index);
+    int getEnd(int index);
+    int getNeighbor(int n);
+    double getShiftX(int n);
+    double getShiftY(int n);
+
+    void saveState(CheckpointWriter *out);
+    void loadState(CheckpointReader *in);
+};
+#endif
@@ -6,13 +6,15 @@
 #include <float.h>
 #include <limits.h>
 
+#include "RNG.h"
+
 /** KISS random number generator class. 
   * Based on UCL Professor David Jones' freely available JKISS RNG found at
   * http://www0.cs.ucl.ac.uk/staff/d.jones/GoodPracticeRNG.pdf. Proper seeding
   * requires the initialization of four unsigned integer variables which are
   * used to generate subsequent random numbers.
   */
-class KISSRNG {
+class KISSRNG : public RNG {
   private:
     bool generate = false;
     double z1;
@@ -30,7 +32,7 @@ class KISSRNG {
      * discards 1000 random numbers (see David Jones' discussion on warming up
      * RNGs).
      */
-    void InitCold(long seed) {
+    void InitCold(long seed) override {
       int seed1 = (int)(seed);
       int seed2 = (int)(seed >> 32);
       x = (seed1 < 0 ? -seed1 : seed1);
@@ -54,6 +56,20 @@ class KISSRNG {
         JKISS();
       }
     }
+    /** The four variables of the generator, which are its whole state for
+     * the uniform numbers, to save it and to continue from it later. */
+    void GetState(unsigned int s[4]) const {
+      s[0] = x;
+      s[1] = y;
+      s[2] = z;
+      s[3] = c;
+    }
+    void SetState(const unsigned int s[4]) {
+      x = s[0];
+      y = s[1];
+      z = s[2];
+      c = s[3];
+    }
     /** Generate a random unsigned integer. */
     unsigned int JKISS() {
       unsigned long long t;
@@ -73,12 +89,19 @@ class KISSRNG {
     }
     /** Higher precision 53 bit random double in [0,1). Samples all possible
      * doubles in range, but requires a few more operations. */
-    double RandomUniformDbl() {
+    double RandomUniformDbl() override {
       unsigned int a = JKISS() >> 6; /* Upper 26 bits */
       unsigned int b = JKISS() >> 5; /* Upper 27 bits */
       double r = (a * 134217728.0 + b) / 9007199254740992.0;
       return r;
     }
+    /** Fills out with n numbers of RandomUniformDbl, with the generator
+     * inlined into the loop. */
+    void FillUniformDbl(double *out, int n) override {
+      for (int i=0; i<n; ++i) {
+        out[i] = KISSRNG::RandomUniformDbl();
+      }
+    }
     /** Returns a random integer in the range [0,9]. Algorithm generates a
      * random 32 bit and returns the last integer in the sequence. Guaranteed
      * to be well-behaved for the JKISS generator.
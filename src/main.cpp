@@ -1,16 +1,43 @@
+#include <cstring>
 #include <iostream>
 #include <string>
 
+#include "Ensemble.h"
+#include "Parameters.h"
+#include "ReplicaExchange.h"
 #include "Simulation.h"
 
 int main(int argc, char *argv[]) {
 
     if (argc > 1) {
-        std::string yamlFile;
+        Parameters param;
+        param.initializeParameters(argv[1]);
 
-        Simulation sim(argv[1]); // initialize the simulation
-        sim.runSimulation();     // run the simulation
-                                 //        sim.testSimulation();
+        // sim params.yaml --restart goes on from the last checkpoint
+        bool restart = argc > 2 && std::strcmp(argv[2], "--restart") == 0;
+
+        if (restart && (param.getReplicaTemps().size() > 1 ||
+                        param.getEnsembleChains() > 1)) {
+            std::cout << "only single runs are checkpointed, starting from "
+                         "the first sweep"
+                      << std::endl;
+        }
+        // a ladder of temperatures runs one replica per temperature
+        if (param.getReplicaTemps().size() > 1) {
+            ReplicaExchange pt;
+            pt.initializeReplicaExchange(argv[1], &param);
+            pt.run();
+        } else if (param.getEnsembleChains() > 1) {
+            // independent chains of the same state point
+            Ensemble ensemble;
+            ensemble.initializeEnsemble(argv[1], &param);
+            ensemble.run();
+        } else {
+            Simulation sim(argv[1], param); // initialize the simulation
+            sim.setRestart(restart);
+            sim.runSimulation();            // run the simulation
+                                            //        sim.testSimulation();
+        }
     } else {
         std::cout << "ERROR: NO .YAML FILE" << std::endl;
     }
@@ -0,0 +1,122 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../src/Parameters.h"
+#include "../src/RdfAnalysis.h"
+#include "../src/Trajectory.h"
+
+/* POST-PROCESSING OF A RUN
+ *   analyze params.yaml [trajectory.bin] [-t threads] [-n samples]
+ *           [-i prefix] [-o prefix]
+ * WITHOUT A TRAJECTORY THE NUMBER DENSITIES WRITTEN BY THE RUN ARE READ, FROM
+ * THE FILES STARTING WITH THE -i prefix (NONE FOR A SINGLE RUN OR THE MERGED
+ * CHAINS OF AN ENSEMBLE, chain2_ FOR ITS THIRD CHAIN); WITH ONE THEY ARE
+ * SAMPLED AGAIN FROM ITS FRAMES. THE RESULTS GO TO FILES STARTING WITH THE
+ * -o prefix (analysis_ IF NOT GIVEN)
+ */
+
+void usage() {
+    std::cout << "usage: analyze params.yaml [trajectory.bin] [-t threads] "
+                 "[-n samples] [-i prefix] [-o prefix]"
+              << std::endl;
+}
+
+// the sweeps the run sampled: after equilibration, every dataInterval. the
+// number densities of an ensemble are those of one chain on average
+long sampledSweeps(Parameters *param) {
+    long interval = param->getData_interval();
+    return (param->getUpdates() - 1) / interval -
+           param->getEq_sweep() / interval;
+}
+
+int main(int argc, char *argv[]) {
+    std::string yaml;
+    std::string traj_file;
+    std::string run_prefix; // of the number densities of the run
+    std::string prefix = "analysis_";
+    int n_threads = std::thread::hardware_concurrency();
+    long n_samples = 0; // 0 = from the parameters
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "-t" || arg == "-n" || arg == "-i" || arg == "-o") &&
+            i + 1 < argc) {
+            std::string value = argv[++i];
+            if (arg == "-t") {
+                n_threads = std::atoi(value.c_str());
+            } else if (arg == "-n") {
+                n_samples = std::atol(value.c_str());
+            } else if (arg == "-i") {
+                run_prefix = value;
+            } else {
+                prefix = value;
+            }
+        } else if (yaml.empty()) {
+            yaml = arg;
+        } else if (traj_file.empty()) {
+            traj_file = arg;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (yaml.empty()) {
+        usage();
+        return 1;
+    }
+
+    Parameters param;
+    param.initializeParameters(yaml);
+    param.setOutputPrefix(prefix);
+
+    RdfAnalysis analysis;
+    analysis.initializeRdfAnalysis(&param, n_threads);
+
+    if (!traj_file.empty()) {
+        TrajectoryReader reader;
+        if (!reader.open(traj_file)) {
+            std::cout << "ERROR: " << traj_file << " IS NOT A TRAJECTORY"
+                      << std::endl;
+            return 1;
+        }
+        if (reader.getNumParticles() != param.getNumParticles()) {
+            std::cout << "ERROR: THE TRAJECTORY HAS "
+                      << reader.getNumParticles() << " PARTICLES"
+                      << std::endl;
+            return 1;
+        }
+        if (reader.getParamsHash() != param.getPhysicsHash()) {
+            std::cout << "the trajectory was written with other parameters "
+                         "than "
+                      << yaml << std::endl;
+        }
+        std::cout << "sampling " << reader.getNumFrames() << " frames on "
+                  << n_threads << " threads" << std::endl;
+        analysis.sampleTrajectory(&reader);
+    } else {
+        if (!analysis.readHistograms(run_prefix)) {
+            std::cout << "ERROR: THE NUMBER DENSITIES " << run_prefix
+                      << "numDensity.txt ... ARE MISSING OR DO NOT MATCH "
+                      << yaml << std::endl;
+            return 1;
+        }
+        analysis.setNumSamples(sampledSweeps(&param));
+    }
+    if (n_samples > 0) {
+        analysis.setNumSamples(n_samples);
+    }
+
+    analysis.calcRDF();
+    analysis.calcPCF();
+    analysis.writeResults(prefix);
+
+    std::cout << analysis.getNumSamples() << " samples, pressure from the "
+              << "virial integral " << analysis.calcPressure()
+              << " (without the tail correction)" << std::endl;
+    std::cout << "wrote " << prefix << "rdf.txt, " << prefix << "pcf.txt, "
+              << prefix << "par_pcf.txt, " << prefix << "antp_pcf.txt and "
+              << prefix << "pressure.txt" << std::endl;
+    return 0;
+}
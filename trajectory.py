@@ -0,0 +1,34 @@
+# reads the binary trajectory.bin written with trajectory_format (see
+# src/Trajectory.h): a header with the number of particles, the box length,
+# the hash of the parameters and the particle types, then frames of one size.
+# the frames are mapped, not read, so even very long trajectories open at once
+#
+#   traj = read_trajectory('trajectory.bin')
+#   traj['xy'][f, k]  # x and y of particle k in frame f
+
+import numpy as np
+
+header_dtype = np.dtype([('magic', 'S8'), ('n_particles', '<i4'),
+                         ('precision', '<i4'), ('header_size', '<i8'),
+                         ('box_length', '<f8'), ('params_hash', '<u8')])
+
+
+def read_trajectory(path):
+    header = np.fromfile(path, dtype=header_dtype, count=1)[0]
+    if header['magic'] != b'MCTRAJ1':
+        raise ValueError(path + ' is not a trajectory')
+    n = int(header['n_particles'])
+    coord = '<f8' if header['precision'] == 8 else '<f4'
+
+    types = np.fromfile(path, dtype='<i4', count=n,
+                        offset=header_dtype.itemsize)
+    frame = np.dtype([('sweep', '<i8'), ('xy', coord, (n, 2))])
+
+    # a frame cut short by a run that was stopped is left out
+    size = np.memmap(path, dtype='u1', mode='r').size
+    n_frames = (size - int(header['header_size'])) // frame.itemsize
+    frames = np.memmap(path, dtype=frame, mode='r',
+                       offset=int(header['header_size']), shape=(n_frames,))
+    return {'n_particles': n, 'box_length': float(header['box_length']),
+            'params_hash': int(header['params_hash']), 'types': types,
+            'sweeps': frames['sweep'], 'xy': frames['xy']}